@@ -0,0 +1,96 @@
+#include "bench.hpp"
+#include "BTreeMap.hpp"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, 1000000);
+	std::mt19937_64 rng(42);
+	Vector<std::uint64_t> keys(size, 0);
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		keys.set(i, rng());
+	}
+	Vector<std::uint64_t> lookups(size, 0);
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		lookups.set(i, keys.get(rng() % size));
+	}
+	
+	BTreeMap<std::uint64_t, std::uint64_t> btree;
+	std::map<std::uint64_t, std::uint64_t> stdmap;
+	
+	benchmark("BTreeMap::set (random)", size, [&]
+	{
+		for(std::uint64_t key : keys)
+		{
+			btree.set(key, key);
+		}
+	});
+	benchmark("std::map::insert_or_assign (random)", size, [&]
+	{
+		for(std::uint64_t key : keys)
+		{
+			stdmap.insert_or_assign(key, key);
+		}
+	});
+	
+	benchmark("BTreeMap::get (random hits)", size, [&]
+	{
+		std::uint64_t sum = 0;
+		for(std::uint64_t key : lookups)
+		{
+			sum += btree.get(key);
+		}
+		do_not_optimize(sum);
+	});
+	benchmark("std::map::find (random hits)", size, [&]
+	{
+		std::uint64_t sum = 0;
+		for(std::uint64_t key : lookups)
+		{
+			sum += stdmap.find(key) -> second;
+		}
+		do_not_optimize(sum);
+	});
+	
+	benchmark("BTreeMap iteration", btree.count(), [&]
+	{
+		std::uint64_t sum = 0;
+		for(auto [key, value] : btree)
+		{
+			sum += value;
+		}
+		do_not_optimize(sum);
+	});
+	benchmark("std::map iteration", stdmap.size(), [&]
+	{
+		std::uint64_t sum = 0;
+		for(const auto &[key, value] : stdmap)
+		{
+			sum += value;
+		}
+		do_not_optimize(sum);
+	});
+	
+	Vector<std::pair<std::uint64_t, std::uint64_t>> sorted(btree.count(), {0, 0});
+	std::size_t pos = 0;
+	for(auto [key, value] : btree)
+	{
+		sorted.set(pos++, {key, value});
+	}
+	BTreeMap<std::uint64_t, std::uint64_t> bulk;
+	benchmark("BTreeMap::build_from_sorted", sorted.count(), [&]
+	{
+		bulk.build_from_sorted(sorted);
+	});
+	
+	// a red-black tree node carries three pointers and a color next to the element, before allocator overhead
+	printf("%-48s %12.2f bytes/entry\n", "BTreeMap memory (random inserts)", (double) btree.memory_usage() / btree.count());
+	printf("%-48s %12.2f bytes/entry\n", "BTreeMap memory (bulk loaded)", (double) bulk.memory_usage() / bulk.count());
+	printf("%-48s %12.2f bytes/entry\n", "std::map memory (lower bound)", (double) sizeof(std::pair<std::uint64_t, std::uint64_t>) + 3 * sizeof(void *) + sizeof(int));
+}
@@ -0,0 +1,62 @@
+#include "bench.hpp"
+#include "ConcurrentVector.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Runs add(thread) on each of `threads` threads and waits for all of them.
+template<class Add>
+void run_writers(std::size_t threads, std::size_t per_thread, Add add)
+{
+	std::unique_ptr<std::thread[]> writers(new std::thread[threads]);
+	for(std::size_t t = 0; t < threads; ++t)
+	{
+		writers[t] = std::thread([&add, t, per_thread]
+		{
+			for(std::size_t i = 0; i < per_thread; ++i)
+			{
+				add(t * per_thread + i);
+			}
+		});
+	}
+	for(std::size_t t = 0; t < threads; ++t)
+	{
+		writers[t].join();
+	}
+}
+
+// Appends from several threads at once, to a mutex-guarded Vector and to a ConcurrentVector.
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(1) << 24);
+	for(std::size_t threads = 1; threads <= 8; threads *= 2)
+	{
+		std::string locked_name = "Vector + mutex, " + std::to_string(threads) + " writers";
+		benchmark(locked_name.c_str(), size, [&]
+		{
+			Vector<std::uint64_t> vec;
+			std::mutex mutex;
+			run_writers(threads, size / threads, [&](std::uint64_t value)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				vec.add_back(value);
+			});
+			do_not_optimize(vec);
+		});
+		
+		std::string concurrent_name = "ConcurrentVector, " + std::to_string(threads) + " writers";
+		benchmark(concurrent_name.c_str(), size, [&]
+		{
+			ConcurrentVector<std::uint64_t> vec;
+			run_writers(threads, size / threads, [&](std::uint64_t value)
+			{
+				vec.add_back(value);
+			});
+			do_not_optimize(vec);
+		});
+	}
+}
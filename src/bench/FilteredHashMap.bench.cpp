@@ -0,0 +1,74 @@
+#include "bench.hpp"
+#include "FilteredHashMap.hpp"
+#include "HashMap.hpp"
+#include "Hashers.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <random>
+
+// Looking up keys that are not in a map far larger than the cache, with and without a filter in front.
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(1) << 22);
+	std::mt19937_64 rng(42);
+	Vector<std::pair<std::uint64_t, std::uint64_t>> elements(size, std::pair<std::uint64_t, std::uint64_t>());
+	Vector<std::uint64_t> misses(size, 0);
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		// even keys are stored, odd keys are looked up
+		elements.set(i, std::pair<std::uint64_t, std::uint64_t>(rng() & ~std::uint64_t(1), i));
+		misses.set(i, rng() | 1);
+	}
+	
+	HashMap<std::uint64_t, std::uint64_t, Hasher> map(elements);
+	benchmark("HashMap: miss", size, [&]
+	{
+		std::size_t found = 0;
+		for(std::uint64_t key : misses)
+		{
+			found += map.contains(key);
+		}
+		do_not_optimize(found);
+	});
+	benchmark("HashMap: hit", size, [&]
+	{
+		std::size_t found = 0;
+		for(const auto &element : elements)
+		{
+			found += map.contains(element.first);
+		}
+		do_not_optimize(found);
+	});
+	
+	FilteredHashMap<std::uint64_t, std::uint64_t, Hasher> bloom_map(elements);
+	benchmark("FilteredHashMap with BlockedBloomFilter: miss", size, [&]
+	{
+		std::size_t found = 0;
+		for(std::uint64_t key : misses)
+		{
+			found += bloom_map.contains(key);
+		}
+		do_not_optimize(found);
+	});
+	benchmark("FilteredHashMap with BlockedBloomFilter: hit", size, [&]
+	{
+		std::size_t found = 0;
+		for(const auto &element : elements)
+		{
+			found += bloom_map.contains(element.first);
+		}
+		do_not_optimize(found);
+	});
+	
+	FilteredHashMap<std::uint64_t, std::uint64_t, Hasher, CuckooFilter<std::uint64_t, Hasher>> cuckoo_map(elements);
+	benchmark("FilteredHashMap with CuckooFilter: miss", size, [&]
+	{
+		std::size_t found = 0;
+		for(std::uint64_t key : misses)
+		{
+			found += cuckoo_map.contains(key);
+		}
+		do_not_optimize(found);
+	});
+}
@@ -0,0 +1,90 @@
+#include "bench.hpp"
+#include "HashMap.hpp"
+#include "Hashers.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <random>
+#include <span>
+
+typedef HashMap<std::uint64_t, std::uint64_t, Hasher> MapType;
+
+// Building a map element by element and in bulk, then random lookups in it (much bigger than
+// the last level cache) one key at a time and in batches of 256 keys.
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(1) << 22);
+	std::mt19937_64 rng(42);
+	Vector<MapType::ElementType> elements(size, MapType::ElementType());
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		elements.set(i, MapType::ElementType(i, i));
+	}
+	
+	// the maps outlive the measurements, so freeing them is not timed
+	MapType map, single_thread_map, threaded_map;
+	benchmark("build with set", size, [&]
+	{
+		for(const MapType::ElementType *element = elements.cbegin(); element != elements.cend(); ++element)
+		{
+			map.set(element -> first, element -> second);
+		}
+	});
+	benchmark("bulk build (1 thread)", size, [&]
+	{
+		single_thread_map = MapType(elements, Hasher(), 0.75f, 1);
+	});
+	benchmark("bulk build (all hardware threads)", size, [&]
+	{
+		threaded_map = MapType(elements);
+	});
+	do_not_optimize(single_thread_map);
+	do_not_optimize(threaded_map);
+	Vector<std::uint64_t> keys(std::size_t(1) << 22, 0);
+	for(std::uint64_t &key : keys)
+	{
+		key = rng() % size;
+	}
+	
+	benchmark("get", keys.count(), [&]
+	{
+		std::uint64_t sum = 0;
+		for(const std::uint64_t *key = keys.cbegin(); key != keys.cend(); ++key)
+		{
+			sum += map.get(*key);
+		}
+		do_not_optimize(sum);
+	});
+	
+	const std::size_t batch = 256;
+	Vector<const std::uint64_t *> values(batch, nullptr);
+	benchmark("get_many (batches of 256)", keys.count(), [&]
+	{
+		std::uint64_t sum = 0;
+		for(std::size_t first = 0; first < keys.count(); first += batch)
+		{
+			const MapType &const_map = map;
+			const_map.get_many(std::span<const std::uint64_t>(keys.cbegin() + first, batch), std::span<const std::uint64_t *>(values.begin(), batch));
+			for(const std::uint64_t *value : values)
+			{
+				sum += *value;
+			}
+		}
+		do_not_optimize(sum);
+	});
+	
+	Vector<bool> found(batch, false);
+	benchmark("contains_many (batches of 256)", keys.count(), [&]
+	{
+		std::size_t hits = 0;
+		for(std::size_t first = 0; first < keys.count(); first += batch)
+		{
+			map.contains_many(std::span<const std::uint64_t>(keys.cbegin() + first, batch), std::span<bool>(found.begin(), batch));
+			for(bool hit : found)
+			{
+				hits += hit;
+			}
+		}
+		do_not_optimize(hits);
+	});
+}
@@ -0,0 +1,70 @@
+#include "bench.hpp"
+#include "HashMap.hpp"
+#include "HashSet.hpp"
+#include "Hashers.hpp"
+#include "Vector.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+// Intersecting two sets of random ids that share about half their elements: a HashMap<id, bool>
+// probed key by key against HashSet, and a plain scalar merge against SortedIntegerSet.
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(1) << 20);
+	std::mt19937 rng(42);
+	Vector<std::uint32_t> a_ids(size, 0), b_ids(size, 0);
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		a_ids.set(i, rng() % (size * 3));
+		b_ids.set(i, rng() % (size * 3));
+	}
+	
+	// both built one key at a time, so that their chains are laid out alike
+	HashMap<std::uint32_t, bool, Hasher> a_map, b_map;
+	HashSet<std::uint32_t, Hasher> a_set, b_set;
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		a_map.set(a_ids.get(i), true);
+		b_map.set(b_ids.get(i), true);
+		a_set.add(a_ids.get(i));
+		b_set.add(b_ids.get(i));
+	}
+	benchmark("HashMap<id, bool>: intersection count", size, [&]
+	{
+		std::size_t length = 0;
+		for(auto it = a_map.cbegin(); it != a_map.cend(); ++it)
+		{
+			length += b_map.contains((*it).first);
+		}
+		do_not_optimize(length);
+	});
+	benchmark("HashSet: intersection count", size, [&]
+	{
+		do_not_optimize(a_set.intersection_count(b_set));
+	});
+	benchmark("HashSet: intersection", size, [&]
+	{
+		do_not_optimize(a_set.set_intersection(b_set).count());
+	});
+	
+	SortedIntegerSet<> a_sorted(a_ids), b_sorted(b_ids);
+	std::vector<std::uint32_t> a_vector(a_sorted.cbegin(), a_sorted.cend()), b_vector(b_sorted.cbegin(), b_sorted.cend());
+	benchmark("std::set_intersection: sorted vectors", size, [&]
+	{
+		std::vector<std::uint32_t> both;
+		std::set_intersection(a_vector.begin(), a_vector.end(), b_vector.begin(), b_vector.end(), std::back_inserter(both));
+		do_not_optimize(both.size());
+	});
+	benchmark("SortedIntegerSet: intersection", size, [&]
+	{
+		do_not_optimize(a_sorted.set_intersection(b_sorted).count());
+	});
+	benchmark("SortedIntegerSet: intersection count", size, [&]
+	{
+		do_not_optimize(a_sorted.intersection_count(b_sorted));
+	});
+}
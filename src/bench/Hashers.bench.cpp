@@ -0,0 +1,121 @@
+#include "bench.hpp"
+#include "Hashers.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+
+template<class HashFunc>
+void integer_throughput(const char *name, const Vector<std::uint64_t> &keys, HashFunc hash_function)
+{
+	benchmark(name, keys.count(), [&]
+	{
+		std::uint64_t sum = 0;
+		for(const std::uint64_t *key = keys.cbegin(); key != keys.cend(); ++key)
+		{
+			sum += hash_function(*key);
+		}
+		do_not_optimize(sum);
+	});
+}
+
+// Reports throughput in bytes per nanosecond besides the time per key.
+template<class HashFunc>
+void string_throughput(const char *name, const std::string &text, std::size_t key_length, std::size_t operations, HashFunc hash_function)
+{
+	std::size_t starts = text.size() - key_length;
+	auto start = std::chrono::steady_clock::now();
+	std::uint64_t sum = 0;
+	for(std::size_t i = 0; i < operations; ++i)
+	{
+		sum += hash_function(std::string_view(text.data() + (i * 61) % starts, key_length));
+	}
+	do_not_optimize(sum);
+	auto end = std::chrono::steady_clock::now();
+	double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+	printf("%-48s %12.2f ns/op %8.2f B/ns\n", name, nanoseconds / operations, double(key_length) * operations / nanoseconds);
+}
+
+// Drops the keys into a power-of-two table indexed by the low bits of the hash. A good hash leaves
+// about 36.8% of the buckets empty (1/e) and no bucket much longer than a handful of keys.
+template<class Key, class HashFunc>
+void distribution(const char *name, const Vector<Key> &keys, HashFunc hash_function)
+{
+	std::size_t bucket_count = 1;
+	while(bucket_count < keys.count())
+	{
+		bucket_count *= 2;
+	}
+	Vector<std::uint32_t> loads(bucket_count, 0);
+	for(const Key *key = keys.cbegin(); key != keys.cend(); ++key)
+	{
+		++loads.get(static_cast<std::size_t>(hash_function(*key)) & (bucket_count - 1));
+	}
+	std::size_t empty = 0;
+	std::uint32_t longest = 0;
+	for(std::uint32_t load : loads)
+	{
+		empty += load == 0;
+		longest = load > longest ? load : longest;
+	}
+	printf("%-48s %11.2f%% empty %6u longest\n", name, 100.0 * empty / bucket_count, longest);
+}
+
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(1) << 22);
+	std::mt19937_64 rng(42);
+	
+	Vector<std::uint64_t> random_keys(size, 0);
+	for(std::uint64_t &key : random_keys)
+	{
+		key = rng();
+	}
+	integer_throughput("integers (std::hash)", random_keys, std::hash<std::uint64_t>());
+	integer_throughput("integers (IntegerHasher)", random_keys, IntegerHasher());
+	
+	std::string text(std::size_t(1) << 20, ' ');
+	for(char &c : text)
+	{
+		c = static_cast<char>('a' + rng() % 26);
+	}
+	const std::size_t key_lengths[] = { 8, 32, 100, 1024, 16384 };
+	for(std::size_t key_length : key_lengths)
+	{
+		std::size_t operations = (std::size_t(256) << 20) / (key_length + 64);
+		std::string std_name = std::to_string(key_length) + " byte strings (std::hash)";
+		std::string our_name = std::to_string(key_length) + " byte strings (StringHasher)";
+		string_throughput(std_name.c_str(), text, key_length, operations, std::hash<std::string_view>());
+		string_throughput(our_name.c_str(), text, key_length, operations, StringHasher());
+	}
+	
+	Vector<std::uint64_t> sequential_keys(size, 0), strided_keys(size, 0);
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		sequential_keys.set(i, i);
+		strided_keys.set(i, i << 12);
+	}
+	distribution("sequential integers (std::hash)", sequential_keys, std::hash<std::uint64_t>());
+	distribution("sequential integers (IntegerHasher)", sequential_keys, IntegerHasher());
+	distribution("integers with stride 4096 (std::hash)", strided_keys, std::hash<std::uint64_t>());
+	distribution("integers with stride 4096 (IntegerHasher)", strided_keys, IntegerHasher());
+	
+	Vector<std::string> numbered_keys(size / 4, std::string());
+	for(std::size_t i = 0; i < numbered_keys.count(); ++i)
+	{
+		numbered_keys.set(i, "key-" + std::to_string(i));
+	}
+	distribution("numbered strings (std::hash)", numbered_keys, std::hash<std::string>());
+	distribution("numbered strings (StringHasher)", numbered_keys, StringHasher());
+	
+	Vector<std::pair<std::uint32_t, std::uint32_t>> grid_keys(size, std::pair<std::uint32_t, std::uint32_t>());
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		grid_keys.set(i, std::pair<std::uint32_t, std::uint32_t>(i / 2048, i % 2048));
+	}
+	distribution("grid coordinate pairs (TupleHasher)", grid_keys, TupleHasher());
+}
@@ -0,0 +1,68 @@
+#include "bench.hpp"
+#include "PriorityQueue.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+// Filling and draining a queue of random keys, against std::priority_queue (a binary heap).
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(1) << 22);
+	std::mt19937_64 rng(42);
+	Vector<std::uint64_t> keys(size, 0);
+	for(std::uint64_t &key : keys)
+	{
+		key = rng();
+	}
+	
+	benchmark("std::priority_queue: push one by one", size, [&]
+	{
+		std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<std::uint64_t>> queue;
+		for(std::uint64_t key : keys)
+		{
+			queue.push(key);
+		}
+		do_not_optimize(queue.top());
+	});
+	benchmark("PriorityQueue: add one by one", size, [&]
+	{
+		PriorityQueue<std::uint64_t> queue;
+		for(std::uint64_t key : keys)
+		{
+			queue.add(key);
+		}
+		do_not_optimize(queue.get_top());
+	});
+	benchmark("PriorityQueue: heapify", size, [&]
+	{
+		PriorityQueue<std::uint64_t> queue(keys);
+		do_not_optimize(queue.get_top());
+	});
+	
+	std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<std::uint64_t>> std_queue(keys.cbegin(), keys.cend());
+	benchmark("std::priority_queue: pop all", size, [&]
+	{
+		std::uint64_t sum = 0;
+		while(!std_queue.empty())
+		{
+			sum += std_queue.top();
+			std_queue.pop();
+		}
+		do_not_optimize(sum);
+	});
+	PriorityQueue<std::uint64_t> queue(keys);
+	benchmark("PriorityQueue: remove all", size, [&]
+	{
+		std::uint64_t sum = 0;
+		while(queue.count() > 0)
+		{
+			sum += queue.get_top();
+			queue.remove_top();
+		}
+		do_not_optimize(sum);
+	});
+}
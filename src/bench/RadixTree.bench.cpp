@@ -0,0 +1,142 @@
+#include "bench.hpp"
+#include "BTreeMap.hpp"
+#include "HashMap.hpp"
+#include "Hashers.hpp"
+#include "RadixTree.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+// A chained HashMap entry is the element and two links, and every bucket is a list of three words.
+template<class Map>
+double hash_map_bytes_per_entry(const Map &map)
+{
+	double bytes = map.count() * (sizeof(typename Map::ElementType) + 2 * sizeof(void *)) + map.bucket_count() * 3 * sizeof(void *);
+	return bytes / map.count();
+}
+
+template<class Tree, class Keys>
+void fill(Tree &tree, const Keys &keys)
+{
+	for(std::size_t i = 0; i < keys.count(); ++i)
+	{
+		tree.set(keys.get(i), i);
+	}
+}
+
+template<class Map, class Keys>
+void lookups(const char *name, const Map &map, const Keys &keys)
+{
+	benchmark(name, keys.count(), [&]
+	{
+		std::uint64_t sum = 0;
+		for(std::size_t i = 0; i < keys.count(); ++i)
+		{
+			sum += map.get(keys.get(i));
+		}
+		do_not_optimize(sum);
+	});
+}
+
+// The radix tree against the hash map and the B+ tree on random and on dense integer keys, where
+// it stores the upper bytes once for many keys, and on string keys sharing long prefixes, where it
+// also answers prefix queries; then the memory each structure takes per entry.
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, 1000000);
+	std::mt19937_64 rng(42);
+	Vector<std::uint64_t> random_keys(size, 0), dense_keys(size, 0), random_lookups(size, 0), dense_lookups(size, 0);
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		random_keys.set(i, rng());
+		dense_keys.set(i, i * 3);
+	}
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		random_lookups.set(i, random_keys.get(rng() % size));
+		dense_lookups.set(i, dense_keys.get(rng() % size));
+	}
+	Vector<std::string> urls(size, std::string());
+	Vector<std::string> url_lookups(size, std::string());
+	const char *hosts[] = { "https://example.com/", "https://example.org/docs/", "https://static.example.net/assets/img/" };
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		urls.set(i, std::string(hosts[rng() % 3]) + "page/" + std::to_string(rng() % (size * 4)) + ".html");
+	}
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		url_lookups.set(i, urls.get(rng() % size));
+	}
+	
+	RadixTree<std::uint64_t, std::uint64_t> radix_random, radix_dense;
+	HashMap<std::uint64_t, std::uint64_t, Hasher> hash_random, hash_dense;
+	BTreeMap<std::uint64_t, std::uint64_t> btree_random, btree_dense;
+	
+	benchmark("RadixTree::set (random)", size, [&] { fill(radix_random, random_keys); });
+	benchmark("HashMap::set (random)", size, [&] { fill(hash_random, random_keys); });
+	benchmark("BTreeMap::set (random)", size, [&] { fill(btree_random, random_keys); });
+	lookups("RadixTree::get (random hits)", radix_random, random_lookups);
+	lookups("HashMap::get (random hits)", hash_random, random_lookups);
+	lookups("BTreeMap::get (random hits)", btree_random, random_lookups);
+	
+	benchmark("RadixTree::set (dense)", size, [&] { fill(radix_dense, dense_keys); });
+	benchmark("HashMap::set (dense)", size, [&] { fill(hash_dense, dense_keys); });
+	benchmark("BTreeMap::set (dense)", size, [&] { fill(btree_dense, dense_keys); });
+	lookups("RadixTree::get (dense hits)", radix_dense, dense_lookups);
+	lookups("HashMap::get (dense hits)", hash_dense, dense_lookups);
+	lookups("BTreeMap::get (dense hits)", btree_dense, dense_lookups);
+	
+	benchmark("RadixTree::for_each (random)", radix_random.count(), [&]
+	{
+		std::uint64_t sum = 0;
+		radix_random.for_each([&](std::uint64_t, std::uint64_t value)
+		{
+			sum += value;
+		});
+		do_not_optimize(sum);
+	});
+	benchmark("BTreeMap iteration (random)", btree_random.count(), [&]
+	{
+		std::uint64_t sum = 0;
+		for(auto [key, value] : btree_random)
+		{
+			sum += value;
+		}
+		do_not_optimize(sum);
+	});
+	
+	RadixTree<std::string, std::uint64_t> radix_urls;
+	HashMap<std::string, std::uint64_t, Hasher> hash_urls;
+	BTreeMap<std::string, std::uint64_t> btree_urls;
+	benchmark("RadixTree::set (urls)", size, [&] { fill(radix_urls, urls); });
+	benchmark("HashMap::set (urls)", size, [&] { fill(hash_urls, urls); });
+	benchmark("BTreeMap::set (urls)", size, [&] { fill(btree_urls, urls); });
+	lookups("RadixTree::get (urls)", radix_urls, url_lookups);
+	lookups("HashMap::get (urls)", hash_urls, url_lookups);
+	lookups("BTreeMap::get (urls)", btree_urls, url_lookups);
+	
+	// one host of three, found by walking down the prefix instead of scanning every key
+	std::string prefix = hosts[1];
+	std::size_t matches = 0;
+	benchmark("RadixTree::for_each_with_prefix (per match)", radix_urls.count() / 3, [&]
+	{
+		radix_urls.for_each_with_prefix(prefix, [&](const std::string &, std::uint64_t)
+		{
+			++matches;
+		});
+	});
+	do_not_optimize(matches);
+	
+	// the radix tree and the B+ tree count their nodes; string keys own more memory on the heap in all three
+	printf("%-48s %12.2f bytes/entry\n", "RadixTree memory (random)", (double) radix_random.memory_usage() / radix_random.count());
+	printf("%-48s %12.2f bytes/entry\n", "HashMap memory (random, estimate)", hash_map_bytes_per_entry(hash_random));
+	printf("%-48s %12.2f bytes/entry\n", "BTreeMap memory (random)", (double) btree_random.memory_usage() / btree_random.count());
+	printf("%-48s %12.2f bytes/entry\n", "RadixTree memory (dense)", (double) radix_dense.memory_usage() / radix_dense.count());
+	printf("%-48s %12.2f bytes/entry\n", "HashMap memory (dense, estimate)", hash_map_bytes_per_entry(hash_dense));
+	printf("%-48s %12.2f bytes/entry\n", "BTreeMap memory (dense)", (double) btree_dense.memory_usage() / btree_dense.count());
+	printf("%-48s %12.2f bytes/entry\n", "RadixTree memory (urls)", (double) radix_urls.memory_usage() / radix_urls.count());
+	printf("%-48s %12.2f bytes/entry\n", "HashMap memory (urls, estimate)", hash_map_bytes_per_entry(hash_urls));
+	printf("%-48s %12.2f bytes/entry\n", "BTreeMap memory (urls)", (double) btree_urls.memory_usage() / btree_urls.count());
+}
@@ -0,0 +1,104 @@
+#include "bench.hpp"
+#include "HashMap.hpp"
+#include "Hashers.hpp"
+#include "SlotMap.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <random>
+
+// Objects created and destroyed in random order, then all visited: a SlotMap against a HashMap from
+// ids to objects, and against a Vector that removes by shifting (on a smaller size, as it is O(n)).
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(1) << 20);
+	std::mt19937 rng(42);
+	Vector<std::uint32_t> victims(size / 2, 0);
+	for(std::uint32_t &victim : victims)
+	{
+		victim = rng();
+	}
+	
+	std::size_t small = size / 64;
+	benchmark("Vector: add all, remove half by shifting", small, [&]
+	{
+		Vector<std::uint64_t> vector(0);
+		for(std::size_t i = 0; i < small; ++i)
+		{
+			vector.add_back(i);
+		}
+		for(std::size_t i = 0; i < small / 2; ++i)
+		{
+			vector.remove(victims.get(i) % vector.count());
+		}
+		do_not_optimize(vector.count());
+	});
+	benchmark("SlotMap: add all, remove half (same size)", small, [&]
+	{
+		SlotMap<std::uint64_t> few;
+		Vector<SlotMap<std::uint64_t>::Handle> handles(small, SlotMap<std::uint64_t>::Handle());
+		for(std::size_t i = 0; i < small; ++i)
+		{
+			handles.set(i, few.add(i));
+		}
+		for(std::size_t i = 0; i < small / 2; ++i)
+		{
+			few.remove(few.handle_at(victims.get(i) % few.count()));
+		}
+		do_not_optimize(few.count());
+	});
+	
+	SlotMap<std::uint64_t> slots;
+	benchmark("SlotMap: add all, remove half", size, [&]
+	{
+		Vector<SlotMap<std::uint64_t>::Handle> handles(size, SlotMap<std::uint64_t>::Handle());
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			handles.set(i, slots.add(i));
+		}
+		for(std::uint32_t victim : victims)
+		{
+			SlotMap<std::uint64_t>::Handle handle = handles.get(victim % size);
+			if(slots.contains(handle))
+			{
+				slots.remove(handle);
+			}
+		}
+		do_not_optimize(slots.count());
+	});
+	HashMap<std::uint32_t, std::uint64_t, Hasher> map;
+	benchmark("HashMap: add all, remove half", size, [&]
+	{
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			map.set(static_cast<std::uint32_t>(i), i);
+		}
+		for(std::uint32_t victim : victims)
+		{
+			if(map.contains(victim % size))
+			{
+				map.remove(victim % size);
+			}
+		}
+		do_not_optimize(map.count());
+	});
+	
+	benchmark("SlotMap: visit all", slots.count(), [&]
+	{
+		std::uint64_t sum = 0;
+		for(std::uint64_t value : slots)
+		{
+			sum += value;
+		}
+		do_not_optimize(sum);
+	});
+	benchmark("HashMap: visit all", map.count(), [&]
+	{
+		std::uint64_t sum = 0;
+		for(auto it = map.cbegin(); it != map.cend(); ++it)
+		{
+			sum += (*it).second;
+		}
+		do_not_optimize(sum);
+	});
+}
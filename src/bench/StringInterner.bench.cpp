@@ -0,0 +1,66 @@
+#include "bench.hpp"
+#include "HashMap.hpp"
+#include "Hashers.hpp"
+#include "StringInterner.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+// A column of strings with many duplicates, kept as separate std::strings or as interned ids.
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(1) << 21);
+	std::size_t distinct = size / 32;
+	std::mt19937_64 rng(42);
+	Vector<std::string> column(size, std::string());
+	for(std::string &value : column)
+	{
+		value = "customer-segment-" + std::to_string(rng() % distinct);
+	}
+	
+	benchmark("Vector<std::string>: copy column", size, [&]
+	{
+		Vector<std::string> copies(column);
+		do_not_optimize(copies.get_back().size());
+	});
+	StringInterner interner;
+	Vector<StringInterner::IdType> ids(size, 0);
+	benchmark("StringInterner: intern column", size, [&]
+	{
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			ids.set(i, interner.intern(column.get(i)));
+		}
+		do_not_optimize(interner.count());
+	});
+	
+	benchmark("std::string: compare neighbours", size, [&]
+	{
+		std::size_t equal = 0;
+		for(std::size_t i = 1; i < size; ++i)
+		{
+			equal += column.get(i) == column.get(i - 1);
+		}
+		do_not_optimize(equal);
+	});
+	benchmark("StringInterner ids: compare neighbours", size, [&]
+	{
+		std::size_t equal = 0;
+		for(std::size_t i = 1; i < size; ++i)
+		{
+			equal += ids.get(i) == ids.get(i - 1);
+		}
+		do_not_optimize(equal);
+	});
+	benchmark("StringInterner: resolve ids", size, [&]
+	{
+		std::size_t bytes = 0;
+		for(StringInterner::IdType id : ids)
+		{
+			bytes += interner.get(id).size();
+		}
+		do_not_optimize(bytes);
+	});
+}
@@ -0,0 +1,78 @@
+#include "bench.hpp"
+#include "TimerWheel.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <span>
+
+// A million timers with random delays, scheduled, half of them cancelled and the rest run to expiry,
+// in the wheel and in a std::multimap ordered by expiry.
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(1) << 20);
+	const std::uint64_t horizon = 1 << 16;
+	std::mt19937_64 rng(42);
+	Vector<std::uint64_t> delays(size, 0);
+	for(std::uint64_t &delay : delays)
+	{
+		delay = rng() % horizon + 1;
+	}
+	
+	TimerWheel<std::uint32_t> wheel;
+	Vector<TimerWheel<std::uint32_t>::TimerHandle> handles(size, TimerWheel<std::uint32_t>::TimerHandle());
+	benchmark("wheel: schedule", size, [&]
+	{
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			handles.set(i, wheel.schedule(delays.get(i), static_cast<std::uint32_t>(i)));
+		}
+	});
+	benchmark("wheel: cancel", size / 2, [&]
+	{
+		for(std::size_t i = 0; i < size; i += 2)
+		{
+			wheel.cancel(handles.get(i));
+		}
+	});
+	benchmark("wheel: advance, per expired timer", size / 2, [&]
+	{
+		std::size_t fired = 0;
+		wheel.advance(horizon, [&fired](std::span<std::uint32_t> expired)
+		{
+			fired += expired.size();
+		});
+		do_not_optimize(fired);
+	});
+	
+	std::multimap<std::uint64_t, std::uint32_t> timers;
+	Vector<std::multimap<std::uint64_t, std::uint32_t>::iterator> positions(size, timers.end());
+	benchmark("multimap: schedule", size, [&]
+	{
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			positions.set(i, timers.emplace(delays.get(i), static_cast<std::uint32_t>(i)));
+		}
+	});
+	benchmark("multimap: cancel", size / 2, [&]
+	{
+		for(std::size_t i = 0; i < size; i += 2)
+		{
+			timers.erase(positions.get(i));
+		}
+	});
+	benchmark("multimap: advance, per expired timer", size / 2, [&]
+	{
+		std::size_t fired = 0;
+		for(std::uint64_t now = 1; now <= horizon; ++now)
+		{
+			while(!timers.empty() && timers.begin() -> first <= now)
+			{
+				timers.erase(timers.begin());
+				++fired;
+			}
+		}
+		do_not_optimize(fired);
+	});
+}
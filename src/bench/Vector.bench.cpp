@@ -0,0 +1,80 @@
+#include "bench.hpp"
+#include "AlignedStorage.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <random>
+
+// Sequential and random scans over one big buffer. The random scan touches a new page almost every
+// access, so it is dominated by TLB misses unless the buffer is backed by huge pages.
+template<class Storage>
+void scans(const char *sequential_name, const char *random_name, std::size_t size, const Vector<std::uint32_t> &indices)
+{
+	Vector<std::uint64_t, Storage> vec(size, 1);
+	
+	benchmark(sequential_name, size, [&]
+	{
+		std::uint64_t sum = 0;
+		for(std::uint64_t elem : vec)
+		{
+			sum += elem;
+		}
+		do_not_optimize(sum);
+	});
+	
+	const std::uint64_t *buffer = vec.cbegin();
+	benchmark(random_name, indices.count(), [&]
+	{
+		std::uint64_t sum = 0;
+		for(const std::uint32_t *index = indices.cbegin(); index != indices.cend(); ++index)
+		{
+			sum += buffer[*index];
+		}
+		do_not_optimize(sum);
+	});
+}
+
+// A 64-bit element with a destructor of its own, so Vector cannot relocate it by its bytes and moves
+// it one by one whenever the buffer grows.
+struct Unrelocatable
+{
+	std::uint64_t value;
+	
+	~Unrelocatable()
+	{}
+};
+
+// Growing by add_back alone, so every doubling of the buffer is part of the measurement.
+template<class Elem, class Storage>
+void growth(const char *name, std::size_t size)
+{
+	benchmark(name, size, [&]
+	{
+		Vector<Elem, Storage> vec;
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			vec.add_back(Elem{ i });
+		}
+		do_not_optimize(vec.cbegin()[size / 2]);
+	});
+}
+
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(64) << 20);
+	std::mt19937 rng(42);
+	Vector<std::uint32_t> indices(std::size_t(16) << 20, 0);
+	for(std::uint32_t &index : indices)
+	{
+		index = rng() % size;
+	}
+	
+	scans<DefaultStorage>("sequential scan (new[])", "random reads (new[])", size, indices);
+	scans<AlignedStorage<CACHE_LINE_ALIGNMENT>>("sequential scan (64 B aligned)", "random reads (64 B aligned)", size, indices);
+	scans<AlignedStorage<PAGE_ALIGNMENT, HUGE_PAGE_SIZE>>("sequential scan (huge pages)", "random reads (huge pages)", size, indices);
+	
+	growth<Unrelocatable, DefaultStorage>("add_back growth (moved one by one)", size);
+	growth<std::uint64_t, DefaultStorage>("add_back growth (realloc)", size);
+	growth<std::uint64_t, AlignedStorage<PAGE_ALIGNMENT>>("add_back growth (aligned, copied)", size);
+	growth<std::uint64_t, AlignedStorage<PAGE_ALIGNMENT, HUGE_PAGE_SIZE>>("add_back growth (huge pages, mremap)", size);
+}
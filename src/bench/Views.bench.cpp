@@ -0,0 +1,57 @@
+#include "bench.hpp"
+#include "Vector.hpp"
+#include "Views.hpp"
+
+#include <cstdint>
+
+// filter -> transform -> collect, once with an intermediate Vector per step and once as a view.
+int main(int argc, char **argv)
+{
+	std::size_t size = bench_size(argc, argv, std::size_t(1) << 24);
+	Vector<std::uint32_t> numbers(size, 0);
+	for(std::size_t i = 0; i < size; ++i)
+	{
+		numbers.set(i, static_cast<std::uint32_t>(i * 2654435761u));
+	}
+	
+	benchmark("materialized steps", size, [&]
+	{
+		Vector<std::uint32_t> filtered(0);
+		for(std::uint32_t x : numbers)
+		{
+			if(x % 3 == 0)
+			{
+				filtered.add_back(x);
+			}
+		}
+		Vector<std::uint64_t> transformed(0);
+		for(std::uint32_t x : filtered)
+		{
+			transformed.add_back(std::uint64_t(x) * x);
+		}
+		do_not_optimize(transformed);
+	});
+	
+	benchmark("fused view", size, [&]
+	{
+		Vector<std::uint64_t> transformed(0);
+		view(numbers).filter([](std::uint32_t x)
+		{
+			return x % 3 == 0;
+		}).transform([](std::uint32_t x)
+		{
+			return std::uint64_t(x) * x;
+		}).collect_into(transformed);
+		do_not_optimize(transformed);
+	});
+	
+	benchmark("transform only, collected with one allocation", size, [&]
+	{
+		Vector<std::uint64_t> transformed(0);
+		view(numbers).transform([](std::uint32_t x)
+		{
+			return std::uint64_t(x) * x;
+		}).collect_into(transformed);
+		do_not_optimize(transformed);
+	});
+}
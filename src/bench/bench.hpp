@@ -0,0 +1,172 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Keeps the compiler from optimizing away a value that is computed only to be measured.
+template<class T>
+void do_not_optimize(const T &value)
+{
+	asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Event counters of the calling process and the threads it starts while they run, read through
+// perf_event_open. Each counter is opened on its own, so one the machine does not have (virtual
+// machines often have no hardware counters at all) is just left out, and where perf_event_open is
+// missing or forbidden there are no counters and benchmarks report their time only.
+class PerfCounters
+{
+public:
+	
+	static constexpr std::size_t COUNT = 6;
+	
+private:
+	
+	struct Event
+	{
+		const char *name;
+		std::uint32_t type;
+		std::uint64_t config;
+	};
+	
+#ifdef __linux__
+	static constexpr Event EVENTS[COUNT] = {
+		{ "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+		{ "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		{ "cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+		{ "branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+		{ "dTLB-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16 },
+		{ "page-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS }
+	};
+#endif
+	
+	int m_fds[COUNT];
+	
+public:
+	
+	PerfCounters()
+	{
+		for(std::size_t i = 0; i < COUNT; ++i)
+		{
+			m_fds[i] = -1;
+#ifdef __linux__
+			perf_event_attr attr = {};
+			attr.size = sizeof(attr);
+			attr.type = EVENTS[i].type;
+			attr.config = EVENTS[i].config;
+			attr.disabled = 1;
+			attr.inherit = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			// the times tell how long the counter was really counting when the PMU is shared between more events
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			m_fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+		}
+	}
+	
+	PerfCounters(const PerfCounters &) = delete;
+	
+	~PerfCounters()
+	{
+#ifdef __linux__
+		for(std::size_t i = 0; i < COUNT; ++i)
+		{
+			if(m_fds[i] >= 0)
+			{
+				close(m_fds[i]);
+			}
+		}
+#endif
+	}
+	
+	PerfCounters &operator=(const PerfCounters &) = delete;
+	
+	const char *name(std::size_t counter) const noexcept
+	{
+#ifdef __linux__
+		return EVENTS[counter].name;
+#else
+		return "";
+#endif
+	}
+	
+	void start() noexcept
+	{
+#ifdef __linux__
+		for(std::size_t i = 0; i < COUNT; ++i)
+		{
+			if(m_fds[i] >= 0)
+			{
+				ioctl(m_fds[i], PERF_EVENT_IOC_RESET, 0);
+				ioctl(m_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+			}
+		}
+#endif
+	}
+	
+	void stop() noexcept
+	{
+#ifdef __linux__
+		for(std::size_t i = 0; i < COUNT; ++i)
+		{
+			if(m_fds[i] >= 0)
+			{
+				ioctl(m_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+			}
+		}
+#endif
+	}
+	
+	// The count since start, scaled up for the time the counter was not scheduled; negative when
+	// the counter could not be read or never ran.
+	double read(std::size_t counter) const noexcept
+	{
+#ifdef __linux__
+		std::uint64_t values[3];
+		if(m_fds[counter] >= 0 && ::read(m_fds[counter], values, sizeof(values)) == sizeof(values) && values[2] > 0)
+		{
+			return static_cast<double>(values[0]) * values[1] / values[2];
+		}
+#endif
+		return -1;
+	}
+};
+
+// Runs func once and prints the average time of each of its `operations` operations, followed by
+// the average count of each event counter that could be read.
+template<class Func>
+void benchmark(const char *name, std::size_t operations, Func func)
+{
+	PerfCounters counters;
+	counters.start();
+	auto start = std::chrono::steady_clock::now();
+	func();
+	auto end = std::chrono::steady_clock::now();
+	counters.stop();
+	double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+	printf("%-48s %12.2f ns/op", name, nanoseconds / operations);
+	for(std::size_t i = 0; i < PerfCounters::COUNT; ++i)
+	{
+		double count = counters.read(i);
+		if(count >= 0)
+		{
+			printf(" %10.2f %s", count / operations, counters.name(i));
+		}
+	}
+	printf("\n");
+}
+
+// The first command line argument, if present, overrides the default element count.
+std::size_t bench_size(int argc, char **argv, std::size_t default_size)
+{
+	return argc > 1 ? std::strtoull(argv[1], nullptr, 10) : default_size;
+}
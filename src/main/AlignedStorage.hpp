@@ -0,0 +1,203 @@
+#ifndef AlignedStorage_HPP
+#define AlignedStorage_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <sys/mman.h>
+
+#include "TriviallyRelocatable.hpp"
+
+// Vector storage with buffers aligned to Alignment bytes (e.g. 64 for cache lines and AVX-512 loads,
+// 4096 for pages). Buffers of at least HugePageThreshold bytes are mapped directly, aligned to
+// a 2 MiB boundary and marked for transparent huge pages, so big scans take far fewer TLB misses.
+// Such a mapping holding trivially relocatable elements is grown with mremap, which moves its pages
+// instead of copying them.
+//
+//     Vector<float, AlignedStorage<64>> samples;
+//     Vector<std::uint64_t, AlignedStorage<4096, HUGE_PAGE_SIZE>> big_table;
+constexpr std::size_t CACHE_LINE_ALIGNMENT = 64;
+constexpr std::size_t PAGE_ALIGNMENT = 4096;
+constexpr std::size_t HUGE_PAGE_SIZE = std::size_t(2) << 20;
+
+template<std::size_t Alignment, std::size_t HugePageThreshold = ~std::size_t(0)>
+struct AlignedStorage
+{
+	static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+	
+	template<class Elem>
+	static Elem *allocate(std::size_t count)
+	{
+		std::size_t bytes = count * sizeof(Elem);
+		void *memory = allocate_bytes(bytes, alignment<Elem>());
+		Elem *buffer = static_cast<Elem *>(memory);
+		std::size_t constructed = 0;
+		try
+		{
+			for(; constructed < count; ++constructed)
+			{
+				new(buffer + constructed) Elem();
+			}
+		}
+		catch(...)
+		{
+			destroy(buffer, constructed);
+			release(memory, bytes, alignment<Elem>());
+			throw;
+		}
+		return buffer;
+	}
+	
+	template<class Elem>
+	static void deallocate(Elem *buffer, std::size_t count)
+	{
+		destroy(buffer, count);
+		release(buffer, count * sizeof(Elem), alignment<Elem>());
+	}
+	
+	// Moves the elements with their bytes; the ones past new_count are destroyed. Between two huge
+	// page mappings nothing is copied, otherwise the bytes are copied once into the new buffer.
+	template<class Elem> requires IsTriviallyRelocatable<Elem>::value && std::is_nothrow_default_constructible_v<Elem>
+	static Elem *reallocate(Elem *buffer, std::size_t old_count, std::size_t new_count)
+	{
+		std::size_t old_bytes = old_count * sizeof(Elem), new_bytes = new_count * sizeof(Elem);
+		if(new_count < old_count)
+		{
+			destroy(buffer + new_count, old_count - new_count);
+		}
+		Elem *moved;
+		if(uses_huge_pages(old_bytes) && uses_huge_pages(new_bytes))
+		{
+			moved = static_cast<Elem *>(remap_huge_pages(buffer, old_bytes, new_bytes));
+			// the pages past the old mapping come fresh from the kernel, already zero, which is what
+			// value-initialization makes of these elements; only the rest of the old last page is not
+			if constexpr(std::is_trivially_default_constructible_v<Elem>)
+			{
+				std::size_t old_length = huge_page_round_up(old_bytes);
+				std::size_t dirty_end = new_bytes < old_length ? new_bytes : old_length;
+				if(dirty_end > old_bytes)
+				{
+					std::memset(reinterpret_cast<char *>(moved) + old_bytes, 0, dirty_end - old_bytes);
+				}
+				return moved;
+			}
+		}
+		else
+		{
+			moved = static_cast<Elem *>(allocate_bytes(new_bytes, alignment<Elem>()));
+			std::memcpy(static_cast<void *>(moved), static_cast<void *>(buffer), (old_bytes < new_bytes ? old_bytes : new_bytes));
+			release(buffer, old_bytes, alignment<Elem>());
+		}
+		for(std::size_t i = old_count; i < new_count; ++i)
+		{
+			new(moved + i) Elem();
+		}
+		return moved;
+	}
+	
+private:
+	
+	template<class Elem>
+	static constexpr std::size_t alignment() noexcept
+	{
+		return Alignment > alignof(Elem) ? Alignment : alignof(Elem);
+	}
+	
+	template<class Elem>
+	static void destroy(Elem *buffer, std::size_t count) noexcept
+	{
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			buffer[i].~Elem();
+		}
+	}
+	
+	static bool uses_huge_pages(std::size_t bytes) noexcept
+	{
+		return bytes != 0 && bytes >= HugePageThreshold;
+	}
+	
+	static std::size_t huge_page_round_up(std::size_t bytes) noexcept
+	{
+		return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+	}
+	
+	static void *allocate_aligned(std::size_t bytes, std::size_t alignment)
+	{
+		return ::operator new(bytes == 0 ? 1 : bytes, std::align_val_t(alignment));
+	}
+	
+	static void *allocate_bytes(std::size_t bytes, std::size_t alignment)
+	{
+		return uses_huge_pages(bytes) ? map_huge_pages(bytes) : allocate_aligned(bytes, alignment);
+	}
+	
+	// Maps one huge page more than needed, then unmaps the slack on both sides of
+	// the first 2 MiB boundary so that the kernel can back the rest with huge pages.
+	static void *map_huge_pages(std::size_t bytes)
+	{
+		std::size_t length = huge_page_round_up(bytes);
+		void *mapping = mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(mapping == MAP_FAILED)
+		{
+			throw std::bad_alloc();
+		}
+		char *start = static_cast<char *>(mapping);
+		char *aligned = reinterpret_cast<char *>(huge_page_round_up(reinterpret_cast<std::size_t>(start)));
+		if(aligned != start)
+		{
+			munmap(start, aligned - start);
+		}
+		std::size_t tail = (start + length + HUGE_PAGE_SIZE) - (aligned + length);
+		if(tail != 0)
+		{
+			munmap(aligned + length, tail);
+		}
+		madvise(aligned, length, MADV_HUGEPAGE);
+		return aligned;
+	}
+	
+	// Grows the mapping in place when the address space after it is free, and otherwise has the
+	// kernel move its pages onto a fresh 2 MiB aligned range; either way no byte is copied.
+	static void *remap_huge_pages(void *memory, std::size_t old_bytes, std::size_t new_bytes)
+	{
+		std::size_t old_length = huge_page_round_up(old_bytes), new_length = huge_page_round_up(new_bytes);
+		char *start = static_cast<char *>(memory);
+		if(new_length <= old_length)
+		{
+			if(new_length < old_length)
+			{
+				munmap(start + new_length, old_length - new_length);
+			}
+			return memory;
+		}
+		if(mremap(memory, old_length, new_length, 0) != MAP_FAILED)
+		{
+			return memory;
+		}
+		void *target = map_huge_pages(new_bytes);
+		if(mremap(memory, old_length, new_length, MREMAP_MAYMOVE | MREMAP_FIXED, target) == MAP_FAILED)
+		{
+			munmap(target, new_length);
+			throw std::bad_alloc();
+		}
+		madvise(target, new_length, MADV_HUGEPAGE);
+		return target;
+	}
+	
+	static void release(void *memory, std::size_t bytes, std::size_t alignment) noexcept
+	{
+		if(uses_huge_pages(bytes))
+		{
+			munmap(memory, huge_page_round_up(bytes));
+		}
+		else
+		{
+			::operator delete(memory, std::align_val_t(alignment));
+		}
+	}
+};
+
+#endif
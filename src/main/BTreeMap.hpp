@@ -0,0 +1,842 @@
+#ifndef BTreeMap_HPP
+#define BTreeMap_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "Vector.hpp"
+
+// Ordered map stored as a B+ tree. Nodes are wide and cache-line-aligned, so a lookup touches
+// a handful of contiguous blocks instead of one allocation per key; values live only in the leaves,
+// which are chained together for range iteration.
+template<class Key, class Value>
+class BTreeMap
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef Value ValueType;
+	typedef std::pair<Key, Value> ElementType;
+	
+	static constexpr SizeType NODE_BYTES = 512;
+	static constexpr SizeType CACHE_LINE_BYTES = 64;
+	
+private:
+	
+	struct Node;
+	
+public:
+	
+	static constexpr SizeType LEAF_CAPACITY =
+		NODE_BYTES / (sizeof(KeyType) + sizeof(ValueType)) < 4 ? 4 : NODE_BYTES / (sizeof(KeyType) + sizeof(ValueType));
+	static constexpr SizeType INNER_CAPACITY =
+		NODE_BYTES / (sizeof(KeyType) + sizeof(Node *)) < 4 ? 4 : NODE_BYTES / (sizeof(KeyType) + sizeof(Node *));
+		
+private:
+	
+	static constexpr SizeType LEAF_MIN = LEAF_CAPACITY / 2;
+	static constexpr SizeType INNER_MIN = INNER_CAPACITY / 2;
+	
+	struct alignas(CACHE_LINE_BYTES) Node
+	{
+		bool leaf;
+		SizeType count;
+	};
+	
+	struct alignas(CACHE_LINE_BYTES) LeafNode : Node
+	{
+		KeyType keys[LEAF_CAPACITY];
+		ValueType values[LEAF_CAPACITY];
+		LeafNode *prev, *next;
+	};
+	
+	// children[i] holds the keys less than keys[i]; children[i + 1] the keys not less than it
+	struct alignas(CACHE_LINE_BYTES) InnerNode : Node
+	{
+		KeyType keys[INNER_CAPACITY];
+		Node *children[INNER_CAPACITY + 1];
+	};
+	
+	struct SplitResult
+	{
+		Node *right;
+		KeyType separator;
+	};
+	
+	class BTreeMapIterator;
+	
+public:
+	
+	typedef BTreeMapIterator IteratorType;
+	
+private:
+	
+	Node *m_root;
+	LeafNode *m_first, *m_last;
+	SizeType m_length;
+	SizeType m_leaf_count, m_inner_count;
+	
+public:
+	
+	BTreeMap()
+		: m_root(nullptr), m_first(nullptr), m_last(nullptr), m_length(0), m_leaf_count(0), m_inner_count(0)
+	{}
+	
+	// Bulk load from elements sorted by strictly ascending keys; the tree is built bottom-up
+	// with every node filled evenly, without a single split.
+	BTreeMap(const Vector<ElementType> &sorted_elements)
+		: BTreeMap()
+	{
+		build_from_sorted(sorted_elements);
+	}
+	
+	BTreeMap(const BTreeMap &other) = delete;
+	
+	BTreeMap(BTreeMap &&other) noexcept
+		: m_root(other.m_root), m_first(other.m_first), m_last(other.m_last), m_length(other.m_length),
+		m_leaf_count(other.m_leaf_count), m_inner_count(other.m_inner_count)
+	{
+		other.m_root = nullptr;
+		other.m_first = nullptr;
+		other.m_last = nullptr;
+		other.m_length = 0;
+		other.m_leaf_count = 0;
+		other.m_inner_count = 0;
+	}
+	
+	~BTreeMap()
+	{
+		clear();
+	}
+	
+	BTreeMap &operator=(const BTreeMap &other) = delete;
+	
+	BTreeMap &operator=(BTreeMap &&other) noexcept
+	{
+		std::swap(m_root, other.m_root);
+		std::swap(m_first, other.m_first);
+		std::swap(m_last, other.m_last);
+		std::swap(m_length, other.m_length);
+		std::swap(m_leaf_count, other.m_leaf_count);
+		std::swap(m_inner_count, other.m_inner_count);
+		return *this;
+	}
+	
+	void build_from_sorted(const Vector<ElementType> &sorted_elements)
+	{
+		SizeType length = sorted_elements.count();
+		const ElementType *source = sorted_elements.cbegin();
+		for(SizeType i = 1; i < length; ++i)
+		{
+			if(!(source[i - 1].first < source[i].first))
+			{
+				throw std::invalid_argument("");
+			}
+		}
+		clear();
+		if(length == 0)
+		{
+			return;
+		}
+		
+		SizeType leaf_count = (length + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+		Vector<Node *> level(leaf_count, nullptr);
+		Vector<KeyType> level_mins(leaf_count, KeyType());
+		SizeType pos = 0;
+		LeafNode *prev = nullptr;
+		for(SizeType i = 0; i < leaf_count; ++i)
+		{
+			LeafNode *leaf = new_leaf();
+			leaf -> count = length / leaf_count + (i < length % leaf_count ? 1 : 0);
+			for(SizeType j = 0; j < leaf -> count; ++j, ++pos)
+			{
+				leaf -> keys[j] = source[pos].first;
+				leaf -> values[j] = source[pos].second;
+			}
+			leaf -> prev = prev;
+			if(prev != nullptr)
+			{
+				prev -> next = leaf;
+			}
+			else
+			{
+				m_first = leaf;
+			}
+			prev = leaf;
+			level.set(i, leaf);
+			level_mins.set(i, leaf -> keys[0]);
+		}
+		m_last = prev;
+		m_length = length;
+		
+		while(level.count() > 1)
+		{
+			SizeType child_count = level.count();
+			SizeType parent_count = (child_count + INNER_CAPACITY) / (INNER_CAPACITY + 1);
+			Vector<Node *> parents(parent_count, nullptr);
+			Vector<KeyType> parent_mins(parent_count, KeyType());
+			SizeType child = 0;
+			for(SizeType i = 0; i < parent_count; ++i)
+			{
+				InnerNode *inner = new_inner();
+				SizeType children = child_count / parent_count + (i < child_count % parent_count ? 1 : 0);
+				inner -> count = children - 1;
+				parent_mins.set(i, level_mins.get(child));
+				for(SizeType j = 0; j < children; ++j, ++child)
+				{
+					inner -> children[j] = level.get(child);
+					if(j > 0)
+					{
+						inner -> keys[j - 1] = level_mins.get(child);
+					}
+				}
+				parents.set(i, inner);
+			}
+			level = std::move(parents);
+			level_mins = std::move(parent_mins);
+		}
+		m_root = level.get(0);
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	// Bytes taken by the nodes of the tree.
+	SizeType memory_usage() const noexcept
+	{
+		return m_leaf_count * sizeof(LeafNode) + m_inner_count * sizeof(InnerNode);
+	}
+	
+	void clear()
+	{
+		if(m_root != nullptr)
+		{
+			delete_subtree(m_root);
+		}
+		m_root = nullptr;
+		m_first = nullptr;
+		m_last = nullptr;
+		m_length = 0;
+	}
+	
+	bool contains(const KeyType &key) const
+	{
+		return find_value(key) != nullptr;
+	}
+	
+	ValueType &get(const KeyType &key)
+	{
+		ValueType *value = find_value(key);
+		if(value == nullptr)
+		{
+			throw std::out_of_range("");
+		}
+		return *value;
+	}
+	
+	const ValueType &get(const KeyType &key) const
+	{
+		const ValueType *value = find_value(key);
+		if(value == nullptr)
+		{
+			throw std::out_of_range("");
+		}
+		return *value;
+	}
+	
+	void set(const KeyType &key, const ValueType &value)
+	{
+		if(m_root == nullptr)
+		{
+			LeafNode *leaf = new_leaf();
+			leaf -> keys[0] = key;
+			leaf -> values[0] = value;
+			leaf -> count = 1;
+			m_root = leaf;
+			m_first = leaf;
+			m_last = leaf;
+			m_length = 1;
+			return;
+		}
+		SplitResult split{ .right = nullptr, .separator = KeyType() };
+		if(insert(m_root, key, value, split))
+		{
+			++m_length;
+		}
+		if(split.right != nullptr)
+		{
+			InnerNode *root = new_inner();
+			root -> count = 1;
+			root -> keys[0] = split.separator;
+			root -> children[0] = m_root;
+			root -> children[1] = split.right;
+			m_root = root;
+		}
+	}
+	
+	void remove(const KeyType &key)
+	{
+		if(m_root == nullptr || !erase(m_root, key))
+		{
+			throw std::out_of_range("");
+		}
+		--m_length;
+		if(!m_root -> leaf && m_root -> count == 0)
+		{
+			InnerNode *old_root = static_cast<InnerNode *>(m_root);
+			m_root = old_root -> children[0];
+			delete_inner(old_root);
+		}
+		else if(m_root -> leaf && m_root -> count == 0)
+		{
+			delete_leaf(static_cast<LeafNode *>(m_root));
+			m_root = nullptr;
+			m_first = nullptr;
+			m_last = nullptr;
+		}
+	}
+	
+	IteratorType begin() const noexcept
+	{
+		return BTreeMapIterator(this, m_first, 0);
+	}
+	
+	IteratorType end() const noexcept
+	{
+		return BTreeMapIterator(this, nullptr, 0);
+	}
+	
+	// Iterator to the first element whose key is not less than the given one.
+	IteratorType lower_bound(const KeyType &key) const
+	{
+		if(m_root == nullptr)
+		{
+			return end();
+		}
+		LeafNode *leaf = find_leaf(key);
+		SizeType pos = leaf_lower_bound(leaf, key);
+		return normalized(leaf, pos);
+	}
+	
+	// Iterator to the first element whose key is greater than the given one.
+	IteratorType upper_bound(const KeyType &key) const
+	{
+		if(m_root == nullptr)
+		{
+			return end();
+		}
+		LeafNode *leaf = find_leaf(key);
+		SizeType pos = leaf_lower_bound(leaf, key);
+		if(pos < leaf -> count && !(key < leaf -> keys[pos]))
+		{
+			++pos;
+		}
+		return normalized(leaf, pos);
+	}
+	
+private:
+	
+	LeafNode *new_leaf()
+	{
+		LeafNode *leaf = new LeafNode();
+		leaf -> leaf = true;
+		leaf -> count = 0;
+		leaf -> prev = nullptr;
+		leaf -> next = nullptr;
+		++m_leaf_count;
+		return leaf;
+	}
+	
+	InnerNode *new_inner()
+	{
+		InnerNode *inner = new InnerNode();
+		inner -> leaf = false;
+		inner -> count = 0;
+		++m_inner_count;
+		return inner;
+	}
+	
+	void delete_leaf(LeafNode *leaf)
+	{
+		delete leaf;
+		--m_leaf_count;
+	}
+	
+	void delete_inner(InnerNode *inner)
+	{
+		delete inner;
+		--m_inner_count;
+	}
+	
+	void delete_subtree(Node *node)
+	{
+		if(node -> leaf)
+		{
+			delete_leaf(static_cast<LeafNode *>(node));
+		}
+		else
+		{
+			InnerNode *inner = static_cast<InnerNode *>(node);
+			for(SizeType i = 0; i <= inner -> count; ++i)
+			{
+				delete_subtree(inner -> children[i]);
+			}
+			delete_inner(inner);
+		}
+	}
+	
+	static SizeType leaf_lower_bound(const LeafNode *leaf, const KeyType &key)
+	{
+		SizeType pos = 0;
+		while(pos < leaf -> count && leaf -> keys[pos] < key)
+		{
+			++pos;
+		}
+		return pos;
+	}
+	
+	// Index of the child whose subtree may hold the key.
+	static SizeType child_index(const InnerNode *inner, const KeyType &key)
+	{
+		SizeType pos = 0;
+		while(pos < inner -> count && !(key < inner -> keys[pos]))
+		{
+			++pos;
+		}
+		return pos;
+	}
+	
+	LeafNode *find_leaf(const KeyType &key) const
+	{
+		Node *node = m_root;
+		while(!node -> leaf)
+		{
+			InnerNode *inner = static_cast<InnerNode *>(node);
+			node = inner -> children[child_index(inner, key)];
+		}
+		return static_cast<LeafNode *>(node);
+	}
+	
+	ValueType *find_value(const KeyType &key) const
+	{
+		if(m_root == nullptr)
+		{
+			return nullptr;
+		}
+		LeafNode *leaf = find_leaf(key);
+		SizeType pos = leaf_lower_bound(leaf, key);
+		if(pos < leaf -> count && !(key < leaf -> keys[pos]))
+		{
+			return &leaf -> values[pos];
+		}
+		return nullptr;
+	}
+	
+	IteratorType normalized(LeafNode *leaf, SizeType pos) const noexcept
+	{
+		if(pos == leaf -> count)
+		{
+			return BTreeMapIterator(this, leaf -> next, 0);
+		}
+		return BTreeMapIterator(this, leaf, pos);
+	}
+	
+	// Returns whether a new key was added. When the node had to split, the new right sibling
+	// and the key separating it from the node are stored in split.
+	bool insert(Node *node, const KeyType &key, const ValueType &value, SplitResult &split)
+	{
+		if(node -> leaf)
+		{
+			return insert_into_leaf(static_cast<LeafNode *>(node), key, value, split);
+		}
+		InnerNode *inner = static_cast<InnerNode *>(node);
+		SizeType index = child_index(inner, key);
+		SplitResult child_split{ .right = nullptr, .separator = KeyType() };
+		bool inserted = insert(inner -> children[index], key, value, child_split);
+		if(child_split.right != nullptr)
+		{
+			insert_into_inner(inner, index, child_split, split);
+		}
+		return inserted;
+	}
+	
+	bool insert_into_leaf(LeafNode *leaf, const KeyType &key, const ValueType &value, SplitResult &split)
+	{
+		SizeType pos = leaf_lower_bound(leaf, key);
+		if(pos < leaf -> count && !(key < leaf -> keys[pos]))
+		{
+			leaf -> values[pos] = value;
+			return false;
+		}
+		if(leaf -> count == LEAF_CAPACITY)
+		{
+			LeafNode *right = new_leaf();
+			SizeType keep = (LEAF_CAPACITY + 1) / 2;
+			for(SizeType i = keep; i < LEAF_CAPACITY; ++i)
+			{
+				right -> keys[i - keep] = std::move(leaf -> keys[i]);
+				right -> values[i - keep] = std::move(leaf -> values[i]);
+			}
+			right -> count = LEAF_CAPACITY - keep;
+			leaf -> count = keep;
+			right -> next = leaf -> next;
+			right -> prev = leaf;
+			if(leaf -> next != nullptr)
+			{
+				leaf -> next -> prev = right;
+			}
+			else
+			{
+				m_last = right;
+			}
+			leaf -> next = right;
+			if(pos > keep)
+			{
+				leaf = right;
+				pos -= keep;
+			}
+			split.right = right;
+		}
+		for(SizeType i = leaf -> count; i > pos; --i)
+		{
+			leaf -> keys[i] = std::move(leaf -> keys[i - 1]);
+			leaf -> values[i] = std::move(leaf -> values[i - 1]);
+		}
+		leaf -> keys[pos] = key;
+		leaf -> values[pos] = value;
+		++leaf -> count;
+		if(split.right != nullptr)
+		{
+			split.separator = static_cast<LeafNode *>(split.right) -> keys[0];
+		}
+		return true;
+	}
+	
+	// Puts child_split.right right after children[index], splitting the node itself if it is full.
+	void insert_into_inner(InnerNode *inner, SizeType index, const SplitResult &child_split, SplitResult &split)
+	{
+		if(inner -> count < INNER_CAPACITY)
+		{
+			for(SizeType i = inner -> count; i > index; --i)
+			{
+				inner -> keys[i] = std::move(inner -> keys[i - 1]);
+				inner -> children[i + 1] = inner -> children[i];
+			}
+			inner -> keys[index] = child_split.separator;
+			inner -> children[index + 1] = child_split.right;
+			++inner -> count;
+			return;
+		}
+		
+		KeyType keys[INNER_CAPACITY + 1];
+		Node *children[INNER_CAPACITY + 2];
+		for(SizeType i = 0, j = 0; i <= INNER_CAPACITY; ++i)
+		{
+			if(i == index)
+			{
+				keys[i] = child_split.separator;
+			}
+			else
+			{
+				keys[i] = std::move(inner -> keys[j++]);
+			}
+		}
+		for(SizeType i = 0, j = 0; i <= INNER_CAPACITY + 1; ++i)
+		{
+			children[i] = (i == index + 1) ? child_split.right : inner -> children[j++];
+		}
+		
+		InnerNode *right = new_inner();
+		SizeType keep = (INNER_CAPACITY + 1) / 2;
+		inner -> count = keep;
+		for(SizeType i = 0; i < keep; ++i)
+		{
+			inner -> keys[i] = std::move(keys[i]);
+			inner -> children[i] = children[i];
+		}
+		inner -> children[keep] = children[keep];
+		right -> count = INNER_CAPACITY - keep;
+		for(SizeType i = 0; i < right -> count; ++i)
+		{
+			right -> keys[i] = std::move(keys[keep + 1 + i]);
+			right -> children[i] = children[keep + 1 + i];
+		}
+		right -> children[right -> count] = children[INNER_CAPACITY + 1];
+		split.right = right;
+		split.separator = std::move(keys[keep]);
+	}
+	
+	// Returns whether the key was found; underfull children are fixed up on the way back.
+	bool erase(Node *node, const KeyType &key)
+	{
+		if(node -> leaf)
+		{
+			LeafNode *leaf = static_cast<LeafNode *>(node);
+			SizeType pos = leaf_lower_bound(leaf, key);
+			if(pos == leaf -> count || key < leaf -> keys[pos])
+			{
+				return false;
+			}
+			--leaf -> count;
+			for(SizeType i = pos; i < leaf -> count; ++i)
+			{
+				leaf -> keys[i] = std::move(leaf -> keys[i + 1]);
+				leaf -> values[i] = std::move(leaf -> values[i + 1]);
+			}
+			return true;
+		}
+		InnerNode *inner = static_cast<InnerNode *>(node);
+		SizeType index = child_index(inner, key);
+		if(!erase(inner -> children[index], key))
+		{
+			return false;
+		}
+		Node *child = inner -> children[index];
+		if(child -> count < (child -> leaf ? LEAF_MIN : INNER_MIN))
+		{
+			rebalance(inner, index);
+		}
+		return true;
+	}
+	
+	void rebalance(InnerNode *parent, SizeType index)
+	{
+		Node *child = parent -> children[index];
+		SizeType min = child -> leaf ? LEAF_MIN : INNER_MIN;
+		if(index > 0 && parent -> children[index - 1] -> count > min)
+		{
+			borrow_from_left(parent, index);
+		}
+		else if(index < parent -> count && parent -> children[index + 1] -> count > min)
+		{
+			borrow_from_right(parent, index);
+		}
+		else if(index > 0)
+		{
+			merge(parent, index - 1);
+		}
+		else if(index < parent -> count)
+		{
+			merge(parent, index);
+		}
+	}
+	
+	void borrow_from_left(InnerNode *parent, SizeType index)
+	{
+		Node *child = parent -> children[index];
+		Node *left = parent -> children[index - 1];
+		if(child -> leaf)
+		{
+			LeafNode *child_leaf = static_cast<LeafNode *>(child);
+			LeafNode *left_leaf = static_cast<LeafNode *>(left);
+			for(SizeType i = child_leaf -> count; i > 0; --i)
+			{
+				child_leaf -> keys[i] = std::move(child_leaf -> keys[i - 1]);
+				child_leaf -> values[i] = std::move(child_leaf -> values[i - 1]);
+			}
+			--left_leaf -> count;
+			child_leaf -> keys[0] = std::move(left_leaf -> keys[left_leaf -> count]);
+			child_leaf -> values[0] = std::move(left_leaf -> values[left_leaf -> count]);
+			++child_leaf -> count;
+			parent -> keys[index - 1] = child_leaf -> keys[0];
+		}
+		else
+		{
+			InnerNode *child_inner = static_cast<InnerNode *>(child);
+			InnerNode *left_inner = static_cast<InnerNode *>(left);
+			child_inner -> children[child_inner -> count + 1] = child_inner -> children[child_inner -> count];
+			for(SizeType i = child_inner -> count; i > 0; --i)
+			{
+				child_inner -> keys[i] = std::move(child_inner -> keys[i - 1]);
+				child_inner -> children[i] = child_inner -> children[i - 1];
+			}
+			child_inner -> keys[0] = std::move(parent -> keys[index - 1]);
+			child_inner -> children[0] = left_inner -> children[left_inner -> count];
+			++child_inner -> count;
+			--left_inner -> count;
+			parent -> keys[index - 1] = std::move(left_inner -> keys[left_inner -> count]);
+		}
+	}
+	
+	void borrow_from_right(InnerNode *parent, SizeType index)
+	{
+		Node *child = parent -> children[index];
+		Node *right = parent -> children[index + 1];
+		if(child -> leaf)
+		{
+			LeafNode *child_leaf = static_cast<LeafNode *>(child);
+			LeafNode *right_leaf = static_cast<LeafNode *>(right);
+			child_leaf -> keys[child_leaf -> count] = std::move(right_leaf -> keys[0]);
+			child_leaf -> values[child_leaf -> count] = std::move(right_leaf -> values[0]);
+			++child_leaf -> count;
+			--right_leaf -> count;
+			for(SizeType i = 0; i < right_leaf -> count; ++i)
+			{
+				right_leaf -> keys[i] = std::move(right_leaf -> keys[i + 1]);
+				right_leaf -> values[i] = std::move(right_leaf -> values[i + 1]);
+			}
+			parent -> keys[index] = right_leaf -> keys[0];
+		}
+		else
+		{
+			InnerNode *child_inner = static_cast<InnerNode *>(child);
+			InnerNode *right_inner = static_cast<InnerNode *>(right);
+			child_inner -> keys[child_inner -> count] = std::move(parent -> keys[index]);
+			child_inner -> children[child_inner -> count + 1] = right_inner -> children[0];
+			++child_inner -> count;
+			parent -> keys[index] = std::move(right_inner -> keys[0]);
+			--right_inner -> count;
+			for(SizeType i = 0; i < right_inner -> count; ++i)
+			{
+				right_inner -> keys[i] = std::move(right_inner -> keys[i + 1]);
+				right_inner -> children[i] = right_inner -> children[i + 1];
+			}
+			right_inner -> children[right_inner -> count] = right_inner -> children[right_inner -> count + 1];
+		}
+	}
+	
+	// Merges children[index + 1] into children[index] and drops the separator between them.
+	void merge(InnerNode *parent, SizeType index)
+	{
+		Node *left = parent -> children[index];
+		Node *right = parent -> children[index + 1];
+		if(left -> leaf)
+		{
+			LeafNode *left_leaf = static_cast<LeafNode *>(left);
+			LeafNode *right_leaf = static_cast<LeafNode *>(right);
+			for(SizeType i = 0; i < right_leaf -> count; ++i)
+			{
+				left_leaf -> keys[left_leaf -> count + i] = std::move(right_leaf -> keys[i]);
+				left_leaf -> values[left_leaf -> count + i] = std::move(right_leaf -> values[i]);
+			}
+			left_leaf -> count += right_leaf -> count;
+			left_leaf -> next = right_leaf -> next;
+			if(right_leaf -> next != nullptr)
+			{
+				right_leaf -> next -> prev = left_leaf;
+			}
+			else
+			{
+				m_last = left_leaf;
+			}
+			delete_leaf(right_leaf);
+		}
+		else
+		{
+			InnerNode *left_inner = static_cast<InnerNode *>(left);
+			InnerNode *right_inner = static_cast<InnerNode *>(right);
+			left_inner -> keys[left_inner -> count] = std::move(parent -> keys[index]);
+			for(SizeType i = 0; i < right_inner -> count; ++i)
+			{
+				left_inner -> keys[left_inner -> count + 1 + i] = std::move(right_inner -> keys[i]);
+				left_inner -> children[left_inner -> count + 1 + i] = right_inner -> children[i];
+			}
+			left_inner -> children[left_inner -> count + 1 + right_inner -> count] = right_inner -> children[right_inner -> count];
+			left_inner -> count += 1 + right_inner -> count;
+			delete_inner(right_inner);
+		}
+		--parent -> count;
+		for(SizeType i = index; i < parent -> count; ++i)
+		{
+			parent -> keys[i] = std::move(parent -> keys[i + 1]);
+			parent -> children[i + 1] = parent -> children[i + 2];
+		}
+	}
+	
+	// Carries its map so that end(), which has no leaf, can still step back to the last element.
+	class BTreeMapIterator
+	{
+		const BTreeMap *m_map;
+		LeafNode *m_leaf;
+		SizeType m_pos;
+		
+	public:
+		
+		BTreeMapIterator(const BTreeMap *map, LeafNode *leaf, SizeType pos)
+			: m_map(map), m_leaf(leaf), m_pos(pos)
+		{}
+		
+		const KeyType &key() const
+		{
+			if(m_leaf == nullptr)
+			{
+				throw std::out_of_range("");
+			}
+			return m_leaf -> keys[m_pos];
+		}
+		
+		ValueType &value() const
+		{
+			if(m_leaf == nullptr)
+			{
+				throw std::out_of_range("");
+			}
+			return m_leaf -> values[m_pos];
+		}
+		
+		std::pair<const KeyType &, ValueType &> operator*() const
+		{
+			if(m_leaf == nullptr)
+			{
+				throw std::out_of_range("");
+			}
+			return std::pair<const KeyType &, ValueType &>(m_leaf -> keys[m_pos], m_leaf -> values[m_pos]);
+		}
+		
+		bool operator==(const BTreeMapIterator &other) const noexcept
+		{
+			return m_leaf == other.m_leaf && m_pos == other.m_pos;
+		}
+		
+		bool operator!=(const BTreeMapIterator &other) const noexcept
+		{
+			return m_leaf != other.m_leaf || m_pos != other.m_pos;
+		}
+		
+		BTreeMapIterator operator++(int)
+		{
+			BTreeMapIterator unincremented(m_map, m_leaf, m_pos);
+			++(*this);
+			return unincremented;
+		}
+		
+		BTreeMapIterator &operator++()
+		{
+			if(++m_pos == m_leaf -> count)
+			{
+				m_leaf = m_leaf -> next;
+				m_pos = 0;
+			}
+			return *this;
+		}
+		
+		BTreeMapIterator operator--(int)
+		{
+			BTreeMapIterator undecremented(m_map, m_leaf, m_pos);
+			--(*this);
+			return undecremented;
+		}
+		
+		BTreeMapIterator &operator--()
+		{
+			if(m_leaf == nullptr)
+			{
+				m_leaf = m_map -> m_last;
+				m_pos = m_leaf -> count;
+			}
+			else if(m_pos == 0)
+			{
+				m_leaf = m_leaf -> prev;
+				m_pos = m_leaf -> count;
+			}
+			--m_pos;
+			return *this;
+		}
+	};
+};
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef BitVector_HPP
+#define BitVector_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "Vector.hpp"
+
+// Vector of bools packed 64 to a word. Bits past the end of the last word are always kept zero,
+// so whole-word operations never have to mask them out.
+class BitVector
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef bool ElementType;
+	typedef std::uint64_t WordType;
+	
+	static constexpr SizeType WORD_BITS = 64;
+	
+private:
+	
+	// four words per operation, compiled to whatever vector registers the target has
+	typedef WordType BlockType __attribute__((vector_size(4 * sizeof(WordType))));
+	static constexpr SizeType BLOCK_WORDS = sizeof(BlockType) / sizeof(WordType);
+	
+	Vector<WordType> m_words;
+	SizeType m_length;
+	
+public:
+	
+	BitVector()
+		: m_words(), m_length(0)
+	{}
+	
+	BitVector(SizeType length, bool value)
+		: m_words((length + WORD_BITS - 1) / WORD_BITS, value ? ~WordType(0) : 0), m_length(length)
+	{
+		clear_unused_bits();
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	// Number of bits that are set.
+	SizeType count_ones() const noexcept
+	{
+		SizeType ones = 0;
+		for(const WordType *word = m_words.cbegin(); word != m_words.cend(); ++word)
+		{
+			ones += std::popcount(*word);
+		}
+		return ones;
+	}
+	
+	void clear()
+	{
+		m_words.clear();
+		m_length = 0;
+	}
+	
+	void add_back(bool value)
+	{
+		if(m_length % WORD_BITS == 0)
+		{
+			m_words.add_back(0);
+		}
+		++m_length;
+		set(m_length - 1, value);
+	}
+	
+	void remove_back()
+	{
+		if(m_length == 0)
+		{
+			throw std::out_of_range("");
+		}
+		set(m_length - 1, false);
+		--m_length;
+		if(m_length % WORD_BITS == 0)
+		{
+			m_words.remove_back();
+		}
+	}
+	
+	bool get(SizeType pos) const
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		return (m_words.get(pos / WORD_BITS) >> (pos % WORD_BITS)) & 1;
+	}
+	
+	void set(SizeType pos, bool value)
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		WordType &word = m_words.get(pos / WORD_BITS);
+		WordType mask = WordType(1) << (pos % WORD_BITS);
+		word = value ? (word | mask) : (word & ~mask);
+	}
+	
+	// Position of the first set bit, or count() if there is none.
+	SizeType find_first() const noexcept
+	{
+		return find_from(0);
+	}
+	
+	// Position of the first set bit after pos, or count() if there is none.
+	SizeType find_next(SizeType pos) const noexcept
+	{
+		return find_from(pos + 1);
+	}
+	
+	BitVector &operator&=(const BitVector &other)
+	{
+		combine(other, [](auto &a, const auto &b) { a &= b; });
+		return *this;
+	}
+	
+	BitVector &operator|=(const BitVector &other)
+	{
+		combine(other, [](auto &a, const auto &b) { a |= b; });
+		return *this;
+	}
+	
+	BitVector &operator^=(const BitVector &other)
+	{
+		combine(other, [](auto &a, const auto &b) { a ^= b; });
+		return *this;
+	}
+	
+	// Clears every bit that is set in other.
+	BitVector &and_not(const BitVector &other)
+	{
+		combine(other, [](auto &a, const auto &b) { a &= ~b; });
+		return *this;
+	}
+	
+	const Vector<WordType> &words() const noexcept
+	{
+		return m_words;
+	}
+	
+private:
+	
+	SizeType word_count() const noexcept
+	{
+		return (m_length + WORD_BITS - 1) / WORD_BITS;
+	}
+	
+	SizeType find_from(SizeType pos) const noexcept
+	{
+		if(pos >= m_length)
+		{
+			return m_length;
+		}
+		const WordType *words = m_words.cbegin();
+		SizeType index = pos / WORD_BITS;
+		WordType word = words[index] & (~WordType(0) << (pos % WORD_BITS));
+		SizeType end = word_count();
+		while(word == 0)
+		{
+			if(++index == end)
+			{
+				return m_length;
+			}
+			word = words[index];
+		}
+		return index * WORD_BITS + std::countr_zero(word);
+	}
+	
+	void clear_unused_bits()
+	{
+		if(m_length % WORD_BITS != 0)
+		{
+			m_words.get_back() &= (WordType(1) << (m_length % WORD_BITS)) - 1;
+		}
+	}
+	
+	template<class Operation>
+	void combine(const BitVector &other, Operation operation)
+	{
+		if(other.m_length != m_length)
+		{
+			throw std::invalid_argument("");
+		}
+		WordType *destination = m_words.begin();
+		const WordType *source = other.m_words.cbegin();
+		SizeType length = word_count();
+		SizeType i = 0;
+		for(; i + BLOCK_WORDS <= length; i += BLOCK_WORDS)
+		{
+			BlockType a, b;
+			std::memcpy(&a, destination + i, sizeof(BlockType));
+			std::memcpy(&b, source + i, sizeof(BlockType));
+			operation(a, b);
+			std::memcpy(destination + i, &a, sizeof(BlockType));
+		}
+		for(; i < length; ++i)
+		{
+			operation(destination[i], source[i]);
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef ConcurrentVector_HPP
+#define ConcurrentVector_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <stdexcept>
+
+// Append-only vector that many threads can add to at once. Elements live in segments that double
+// in size (FIRST_SEGMENT_SIZE, FIRST_SEGMENT_SIZE, 2 * FIRST_SEGMENT_SIZE, ...), so growing never
+// moves an element and references stay valid. add_back claims a position with one fetch-add and
+// writes the element there; the only other synchronization is the rare allocation of a segment.
+//
+// count() is the number of claimed positions, which may include elements still being written by
+// add_back calls in progress. Reads take no locks; an element can be read once the add_back that
+// returned its position happens-before the read (e.g. after joining the writers).
+template<class Elem>
+class ConcurrentVector
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Elem ElementType;
+	
+	static constexpr SizeType FIRST_SEGMENT_BITS = 6;
+	static constexpr SizeType FIRST_SEGMENT_SIZE = SizeType(1) << FIRST_SEGMENT_BITS;
+	
+private:
+	
+	static constexpr SizeType MAX_SEGMENTS = sizeof(SizeType) * 8 - FIRST_SEGMENT_BITS + 1;
+	
+	struct Location
+	{
+		SizeType segment, offset;
+	};
+	
+	std::atomic<SizeType> m_length;
+	std::atomic<ElementType *> m_segments[MAX_SEGMENTS];
+	std::atomic<bool> m_allocating[MAX_SEGMENTS];
+	
+public:
+	
+	ConcurrentVector() noexcept
+		: m_length(0), m_segments(), m_allocating()
+	{}
+	
+	ConcurrentVector(const ConcurrentVector &other) = delete;
+	
+	~ConcurrentVector()
+	{
+		for(std::atomic<ElementType *> &segment : m_segments)
+		{
+			delete[] segment.load(std::memory_order_relaxed);
+		}
+	}
+	
+	ConcurrentVector &operator=(const ConcurrentVector &other) = delete;
+	
+	// Returns the position the element was written to.
+	SizeType add_back(const ElementType &value)
+	{
+		SizeType pos = m_length.fetch_add(1, std::memory_order_relaxed);
+		Location location = locate(pos);
+		ElementType *segment = m_segments[location.segment].load(std::memory_order_acquire);
+		if(segment == nullptr)
+		{
+			segment = allocate_segment(location.segment);
+		}
+		segment[location.offset] = value;
+		return pos;
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_length.load(std::memory_order_acquire);
+	}
+	
+	ElementType &get(SizeType pos)
+	{
+		if(pos >= count())
+		{
+			throw std::out_of_range("");
+		}
+		Location location = locate(pos);
+		return m_segments[location.segment].load(std::memory_order_acquire)[location.offset];
+	}
+	
+	const ElementType &get(SizeType pos) const
+	{
+		return const_cast<ConcurrentVector *>(this) -> get(pos);
+	}
+	
+private:
+	
+	static constexpr SizeType segment_size(SizeType segment) noexcept
+	{
+		return segment == 0 ? FIRST_SEGMENT_SIZE : FIRST_SEGMENT_SIZE << (segment - 1);
+	}
+	
+	// Segment k > 0 starts at position FIRST_SEGMENT_SIZE << (k - 1), so it is found from the highest set bit.
+	static constexpr Location locate(SizeType pos) noexcept
+	{
+		if(pos < FIRST_SEGMENT_SIZE)
+		{
+			return Location{ .segment = 0, .offset = pos };
+		}
+		SizeType high_bit = std::bit_width(pos) - 1;
+		return Location{ .segment = high_bit - FIRST_SEGMENT_BITS + 1, .offset = pos - (SizeType(1) << high_bit) };
+	}
+	
+	// The first writer to find the segment missing claims it and allocates it; the others wait
+	// for it to be published rather than each building a whole segment only to free it. A claim
+	// is released when the allocation throws, so a waiting writer can try in its place.
+	ElementType *allocate_segment(SizeType segment)
+	{
+		std::atomic<bool> &allocating = m_allocating[segment];
+		while(true)
+		{
+			ElementType *published = m_segments[segment].load(std::memory_order_acquire);
+			if(published != nullptr)
+			{
+				return published;
+			}
+			if(allocating.exchange(true, std::memory_order_acquire))
+			{
+				allocating.wait(true, std::memory_order_relaxed);
+				continue;
+			}
+			// the claim may have been released right after the segment was published
+			published = m_segments[segment].load(std::memory_order_acquire);
+			if(published == nullptr)
+			{
+				try
+				{
+					published = new ElementType[segment_size(segment)];
+				}
+				catch(...)
+				{
+					allocating.store(false, std::memory_order_release);
+					allocating.notify_all();
+					throw;
+				}
+				m_segments[segment].store(published, std::memory_order_release);
+			}
+			allocating.store(false, std::memory_order_release);
+			allocating.notify_all();
+			return published;
+		}
+	}
+};
+
+#endif
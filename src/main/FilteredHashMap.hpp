@@ -0,0 +1,166 @@
+#ifndef FilteredHashMap_HPP
+#define FilteredHashMap_HPP
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "Filters.hpp"
+#include "HashMap.hpp"
+
+// HashMap behind an approximate membership filter, for maps that are mostly asked about keys they
+// do not hold: the filter turns almost every miss away after one cache line, without walking a
+// bucket chain. Filter is BlockedBloomFilter or CuckooFilter. A Bloom filter cannot forget keys, so
+// removed keys keep passing it until the next rebuild; the filter is rebuilt from the map at twice
+// the size whenever the map outgrows it.
+template<class Key, class Value, class HashFunc, class Filter = BlockedBloomFilter<Key, HashFunc>>
+class FilteredHashMap
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef Value ValueType;
+	typedef typename HashMap<Key, Value, HashFunc>::ElementType ElementType;
+	typedef HashFunc HasherType;
+	typedef Filter FilterType;
+	typedef typename HashMap<Key, Value, HashFunc>::ConstIteratorType ConstIteratorType;
+	
+	static constexpr SizeType MIN_FILTER_CAPACITY = 64;
+	
+private:
+	
+	HashMap<Key, Value, HashFunc> m_map;
+	FilterType m_filter;
+	HasherType m_hasher;
+	
+public:
+	
+	FilteredHashMap(const HasherType &hash_function = HasherType(), SizeType expected_count = MIN_FILTER_CAPACITY)
+		: m_map(hash_function),
+		m_filter(expected_count < MIN_FILTER_CAPACITY ? MIN_FILTER_CAPACITY : expected_count, hash_function),
+		m_hasher(hash_function)
+	{}
+	
+	// Bulk build of the map, as for HashMap, with the filter sized for it.
+	FilteredHashMap(const Vector<ElementType> &elements, const HasherType &hash_function = HasherType())
+		: m_map(elements, hash_function),
+		m_filter(m_map.count() < MIN_FILTER_CAPACITY ? MIN_FILTER_CAPACITY : m_map.count(), hash_function),
+		m_hasher(hash_function)
+	{
+		if(!fill_filter())
+		{
+			rebuild_filter(m_filter.capacity() * 2);
+		}
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_map.count();
+	}
+	
+	const FilterType &filter() const noexcept
+	{
+		return m_filter;
+	}
+	
+	bool contains(const KeyType &key) const
+	{
+		return m_filter.contains(key) && m_map.contains(key);
+	}
+	
+	const ValueType &get(const KeyType &key) const
+	{
+		if(!m_filter.contains(key))
+		{
+			throw std::out_of_range("");
+		}
+		return m_map.get(key);
+	}
+	
+	ValueType &get(const KeyType &key)
+	{
+		return const_cast<ValueType &>(static_cast<const FilteredHashMap *>(this) -> get(key));
+	}
+	
+	// Inserts the key, or overwrites its value when it is already present.
+	void set(const KeyType &key, const ValueType &value)
+	{
+		SizeType old_count = m_map.count();
+		m_map.set(key, value);
+		if(m_map.count() == old_count)
+		{
+			return;
+		}
+		if(m_map.count() > m_filter.capacity() || !add_to_filter(key))
+		{
+			rebuild_filter(m_filter.capacity() * 2);
+		}
+	}
+	
+	void remove(const KeyType &key)
+	{
+		m_map.remove(key);
+		if constexpr(FilterType::SUPPORTS_REMOVE)
+		{
+			m_filter.remove(key);
+		}
+	}
+	
+	void clear()
+	{
+		m_map.clear();
+		m_filter.clear();
+	}
+	
+	ConstIteratorType cbegin() const noexcept
+	{
+		return m_map.cbegin();
+	}
+	
+	ConstIteratorType cend() const noexcept
+	{
+		return m_map.cend();
+	}
+	
+private:
+	
+	// The Bloom filter always takes a key; the cuckoo filter may be too full, and may then have dropped
+	// the key, so the caller rebuilds the filter on false.
+	bool add_to_filter(const KeyType &key)
+	{
+		if constexpr(FilterType::SUPPORTS_REMOVE)
+		{
+			return m_filter.add(key);
+		}
+		else
+		{
+			m_filter.add(key);
+			return true;
+		}
+	}
+	
+	// Adds every key of the map; false when the filter ran out of room.
+	bool fill_filter()
+	{
+		for(auto it = m_map.cbegin(); it != m_map.cend(); ++it)
+		{
+			if(!add_to_filter((*it).first))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	
+	void rebuild_filter(SizeType capacity)
+	{
+		m_filter = FilterType(capacity, m_hasher);
+		while(!fill_filter())
+		{
+			capacity *= 2;
+			m_filter = FilterType(capacity, m_hasher);
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,319 @@
+#ifndef Filters_HPP
+#define Filters_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "AlignedStorage.hpp"
+#include "Hashers.hpp"
+#include "Vector.hpp"
+
+// Approximate membership filters. contains never answers false for a key that was added (for
+// CuckooFilter, one that add did not refuse), and answers true for a key that was not added with
+// a small false positive rate. The key hash is
+// mixed once more, so that the filter does not follow the bucket the key lands in in a HashMap
+// that uses the same hasher.
+
+// Bloom filter split into 64-byte blocks. A key picks one block and sets one bit in each of its
+// eight words, so every lookup reads one cache line, and the eight bit positions are computed
+// and tested as one vector. With the default 12 bits per key about 0.5% of misses get through.
+template<class Key, class HashFunc>
+class BlockedBloomFilter
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef HashFunc HasherType;
+	
+	static constexpr bool SUPPORTS_REMOVE = false;
+	
+private:
+	
+	typedef std::uint64_t BlockType __attribute__((vector_size(64)));
+	typedef std::uint32_t SaltType __attribute__((vector_size(32)));
+	
+	static constexpr SizeType BLOCK_BITS = 512;
+	
+	// odd multipliers that turn one 32-bit hash into eight roughly independent bit positions
+	static constexpr SaltType SALT = {
+		0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+		0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+	};
+	
+	Vector<BlockType, AlignedStorage<CACHE_LINE_ALIGNMENT>> m_blocks;
+	SizeType m_capacity;
+	HasherType m_hasher;
+	
+public:
+	
+	// Sized for capacity keys; it keeps working past that, with a growing false positive rate.
+	BlockedBloomFilter(SizeType capacity, const HasherType &hash_function = HasherType(), SizeType bits_per_key = 12)
+		: m_blocks((capacity * bits_per_key + BLOCK_BITS - 1) / BLOCK_BITS + 1, BlockType{}),
+		m_capacity(capacity),
+		m_hasher(hash_function)
+	{}
+	
+	SizeType capacity() const noexcept
+	{
+		return m_capacity;
+	}
+	
+	void add(const KeyType &key)
+	{
+		std::uint64_t hash = hash_of(key);
+		BlockType mask;
+		mask_of(hash, mask);
+		m_blocks.get(block_of(hash)) |= mask;
+	}
+	
+	bool contains(const KeyType &key) const
+	{
+		std::uint64_t hash = hash_of(key);
+		BlockType mask;
+		mask_of(hash, mask);
+		BlockType missing = mask & ~m_blocks.get(block_of(hash));
+		// no lane may have a bit of the mask missing
+		BlockType folded = missing | __builtin_shuffle(missing, BlockType{4, 5, 6, 7, 0, 1, 2, 3});
+		return (folded[0] | folded[1] | folded[2] | folded[3]) == 0;
+	}
+	
+	void clear()
+	{
+		m_blocks = Vector<BlockType, AlignedStorage<CACHE_LINE_ALIGNMENT>>(m_blocks.count(), BlockType{});
+	}
+	
+private:
+	
+	std::uint64_t hash_of(const KeyType &key) const
+	{
+		return IntegerHasher::mix(static_cast<std::uint64_t>(m_hasher(key)));
+	}
+	
+	// The high half of the hash picks the block by multiply-shift, the low half the bits.
+	SizeType block_of(std::uint64_t hash) const noexcept
+	{
+		return static_cast<SizeType>(((hash >> 32) * m_blocks.count()) >> 32);
+	}
+	
+	// Passed out by reference: returning a 64-byte vector by value has a different ABI on AVX-512 targets.
+	static void mask_of(std::uint64_t hash, BlockType &mask) noexcept
+	{
+		SaltType bits = (SALT * static_cast<std::uint32_t>(hash)) >> 26;
+		mask = (BlockType{} + 1) << __builtin_convertvector(bits, BlockType);
+	}
+};
+
+// Cuckoo filter: a 16-bit fingerprint of each key sits in one of two buckets of four, and the
+// second bucket can be found from the first and the fingerprint alone, so a fingerprint can be
+// moved between them and removed again. A bucket is one 64-bit word, tested for the fingerprint
+// in a few word operations. Lookups read at most two words; about 0.01% of misses get through.
+// Only keys that were added may be removed, or the fingerprint of another key may go instead.
+template<class Key, class HashFunc>
+class CuckooFilter
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef HashFunc HasherType;
+	
+	static constexpr bool SUPPORTS_REMOVE = true;
+	static constexpr SizeType BUCKET_SLOTS = 4;
+	
+	// how many fingerprints add displaces before it gives up
+	static constexpr SizeType MAX_KICKS = 500;
+	
+private:
+	
+	static constexpr std::uint64_t LOW_LANES = 0x0001000100010001ull;
+	static constexpr std::uint64_t HIGH_LANES = 0x8000800080008000ull;
+	
+	Vector<std::uint64_t> m_buckets;
+	SizeType m_capacity, m_length;
+	// a fingerprint that found no room, kept so that it is never lost; 0 when unused
+	std::uint16_t m_victim;
+	SizeType m_victim_bucket;
+	std::uint64_t m_kick_state;
+	HasherType m_hasher;
+	
+public:
+	
+	// The bucket count is a power of two, sized so that capacity keys fill at most 95% of the slots.
+	CuckooFilter(SizeType capacity, const HasherType &hash_function = HasherType())
+		: m_buckets(std::bit_ceil(capacity * 100 / 95 / BUCKET_SLOTS + 1), 0),
+		m_capacity(capacity),
+		m_length(0),
+		m_victim(0),
+		m_victim_bucket(0),
+		m_kick_state(0x9E3779B97F4A7C15ull),
+		m_hasher(hash_function)
+	{}
+	
+	SizeType capacity() const noexcept
+	{
+		return m_capacity;
+	}
+	
+	// The number of fingerprints stored, counting duplicates.
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	// Returns false when the filter is too full to take the key. The first time that happens, the
+	// fingerprint left without a slot is kept aside, so that key is still found. After that, until
+	// a key is removed, add returns false right away and the key is NOT added: contains may then
+	// answer false for it, so the caller has to keep such keys elsewhere or rebuild the filter larger.
+	bool add(const KeyType &key)
+	{
+		if(m_victim != 0)
+		{
+			return false;
+		}
+		std::uint64_t hash = hash_of(key);
+		std::uint16_t fingerprint = fingerprint_of(hash);
+		SizeType bucket = bucket_of(hash);
+		++m_length;
+		if(put(bucket, fingerprint) || put(other_bucket(bucket, fingerprint), fingerprint))
+		{
+			return true;
+		}
+		for(SizeType kick = 0; kick < MAX_KICKS; ++kick)
+		{
+			// swap the fingerprint with a random one of the bucket and move that one to its other bucket
+			m_kick_state ^= m_kick_state << 13;
+			m_kick_state ^= m_kick_state >> 7;
+			m_kick_state ^= m_kick_state << 17;
+			SizeType shift = (m_kick_state % BUCKET_SLOTS) * 16;
+			std::uint64_t &word = m_buckets.get(bucket);
+			std::uint16_t evicted = static_cast<std::uint16_t>(word >> shift);
+			word = (word & ~(std::uint64_t(0xFFFF) << shift)) | std::uint64_t(fingerprint) << shift;
+			fingerprint = evicted;
+			bucket = other_bucket(bucket, fingerprint);
+			if(put(bucket, fingerprint))
+			{
+				return true;
+			}
+		}
+		m_victim = fingerprint;
+		m_victim_bucket = bucket;
+		return false;
+	}
+	
+	bool contains(const KeyType &key) const
+	{
+		std::uint64_t hash = hash_of(key);
+		std::uint16_t fingerprint = fingerprint_of(hash);
+		SizeType bucket = bucket_of(hash);
+		SizeType alternate = other_bucket(bucket, fingerprint);
+		if(has(m_buckets.get(bucket), fingerprint) || has(m_buckets.get(alternate), fingerprint))
+		{
+			return true;
+		}
+		return m_victim == fingerprint && (m_victim_bucket == bucket || m_victim_bucket == alternate);
+	}
+	
+	// Returns false when no fingerprint of the key was found.
+	bool remove(const KeyType &key)
+	{
+		std::uint64_t hash = hash_of(key);
+		std::uint16_t fingerprint = fingerprint_of(hash);
+		SizeType bucket = bucket_of(hash);
+		SizeType alternate = other_bucket(bucket, fingerprint);
+		if(m_victim == fingerprint && (m_victim_bucket == bucket || m_victim_bucket == alternate))
+		{
+			m_victim = 0;
+		}
+		else if(!take(bucket, fingerprint) && !take(alternate, fingerprint))
+		{
+			return false;
+		}
+		--m_length;
+		// the victim may fit now that a slot is free
+		if(m_victim != 0)
+		{
+			std::uint16_t victim = m_victim;
+			m_victim = 0;
+			if(!put(m_victim_bucket, victim) && !put(other_bucket(m_victim_bucket, victim), victim))
+			{
+				m_victim = victim;
+			}
+		}
+		return true;
+	}
+	
+	void clear()
+	{
+		m_buckets = Vector<std::uint64_t>(m_buckets.count(), 0);
+		m_length = 0;
+		m_victim = 0;
+	}
+	
+private:
+	
+	std::uint64_t hash_of(const KeyType &key) const
+	{
+		return IntegerHasher::mix(static_cast<std::uint64_t>(m_hasher(key)));
+	}
+	
+	SizeType bucket_of(std::uint64_t hash) const noexcept
+	{
+		return static_cast<SizeType>(hash) & (m_buckets.count() - 1);
+	}
+	
+	// 0 marks an empty slot, so it is never a fingerprint.
+	static std::uint16_t fingerprint_of(std::uint64_t hash) noexcept
+	{
+		std::uint16_t fingerprint = static_cast<std::uint16_t>(hash >> 48);
+		return fingerprint == 0 ? 1 : fingerprint;
+	}
+	
+	// XOR with a hash of the fingerprint, so that applying it twice leads back to the first bucket.
+	SizeType other_bucket(SizeType bucket, std::uint16_t fingerprint) const noexcept
+	{
+		return (bucket ^ static_cast<SizeType>(IntegerHasher::mix(fingerprint))) & (m_buckets.count() - 1);
+	}
+	
+	// Whether any of the four 16-bit lanes of the word is zero, without looking at them one by one.
+	static bool has_zero_lane(std::uint64_t word) noexcept
+	{
+		return ((word - LOW_LANES) & ~word & HIGH_LANES) != 0;
+	}
+	
+	static bool has(std::uint64_t word, std::uint16_t fingerprint) noexcept
+	{
+		return has_zero_lane(word ^ (fingerprint * LOW_LANES));
+	}
+	
+	bool put(SizeType bucket, std::uint16_t fingerprint)
+	{
+		std::uint64_t &word = m_buckets.get(bucket);
+		for(SizeType shift = 0; shift < 64; shift += 16)
+		{
+			if(((word >> shift) & 0xFFFF) == 0)
+			{
+				word |= std::uint64_t(fingerprint) << shift;
+				return true;
+			}
+		}
+		return false;
+	}
+	
+	bool take(SizeType bucket, std::uint16_t fingerprint)
+	{
+		std::uint64_t &word = m_buckets.get(bucket);
+		for(SizeType shift = 0; shift < 64; shift += 16)
+		{
+			if(((word >> shift) & 0xFFFF) == fingerprint)
+			{
+				word &= ~(std::uint64_t(0xFFFF) << shift);
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+#endif
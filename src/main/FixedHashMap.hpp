@@ -0,0 +1,114 @@
+#ifndef FixedHashMap_HPP
+#define FixedHashMap_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+// Open-addressing hash map with a fixed number of slots and no heap storage. Everything is constexpr,
+// so a table built in a constant expression (directly, or from a Vector inside a constexpr lambda)
+// ends up in the binary fully formed. HashFunc has to be callable in constant evaluation.
+template<class Key, class Value, class HashFunc, std::size_t Capacity>
+class FixedHashMap
+{
+	static_assert(Capacity > 0, "FixedHashMap needs at least one slot");
+	
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef Value ValueType;
+	typedef std::pair<Key, Value> ElementType;
+	typedef HashFunc HasherType;
+	
+private:
+	
+	KeyType m_keys[Capacity];
+	ValueType m_values[Capacity];
+	bool m_occupied[Capacity];
+	SizeType m_length;
+	HasherType m_hasher;
+	
+public:
+	
+	constexpr FixedHashMap(const HasherType &hash_function = HasherType())
+		: m_keys(), m_values(), m_occupied(), m_length(0), m_hasher(hash_function)
+	{}
+	
+	constexpr FixedHashMap(std::initializer_list<ElementType> elements, const HasherType &hash_function = HasherType())
+		: FixedHashMap(hash_function)
+	{
+		for(const ElementType &element : elements)
+		{
+			set(element.first, element.second);
+		}
+	}
+	
+	constexpr SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	constexpr SizeType capacity() const noexcept
+	{
+		return Capacity;
+	}
+	
+	constexpr bool contains(const KeyType &key) const
+	{
+		return m_occupied[find_slot(key)];
+	}
+	
+	constexpr ValueType &get(const KeyType &key)
+	{
+		SizeType slot = find_slot(key);
+		if(!m_occupied[slot])
+		{
+			throw std::out_of_range("");
+		}
+		return m_values[slot];
+	}
+	
+	constexpr const ValueType &get(const KeyType &key) const
+	{
+		SizeType slot = find_slot(key);
+		if(!m_occupied[slot])
+		{
+			throw std::out_of_range("");
+		}
+		return m_values[slot];
+	}
+	
+	constexpr void set(const KeyType &key, const ValueType &value)
+	{
+		SizeType slot = find_slot(key);
+		if(!m_occupied[slot])
+		{
+			// one slot always stays empty so that a lookup of a missing key terminates
+			if(m_length + 1 >= Capacity)
+			{
+				throw std::length_error("");
+			}
+			m_keys[slot] = key;
+			m_occupied[slot] = true;
+			++m_length;
+		}
+		m_values[slot] = value;
+	}
+	
+private:
+	
+	// The slot holding the key, or the empty slot where it would go.
+	constexpr SizeType find_slot(const KeyType &key) const
+	{
+		SizeType slot = static_cast<SizeType>(m_hasher(key)) % Capacity;
+		while(m_occupied[slot] && !(m_keys[slot] == key))
+		{
+			slot = slot + 1 == Capacity ? 0 : slot + 1;
+		}
+		return slot;
+	}
+};
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef FlatMap_HPP
+#define FlatMap_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "Vector.hpp"
+
+// Sorted map kept in two parallel arrays, keys and values, so that lookups only touch the key array.
+// Meant for read-mostly maps: build it in bulk, then query; add and remove shift elements around.
+template<class Key, class Value>
+class FlatMap
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef Value ValueType;
+	typedef std::pair<Key, Value> ElementType;
+	
+private:
+	
+	Vector<KeyType> m_keys;
+	Vector<ValueType> m_values;
+	
+public:
+	
+	FlatMap()
+		: m_keys(), m_values()
+	{}
+	
+	// Sorts the elements once; when a key appears more than once, the last occurrence wins.
+	FlatMap(const Vector<ElementType> &elements)
+		: FlatMap()
+	{
+		build(elements);
+	}
+	
+	void build(const Vector<ElementType> &elements)
+	{
+		SizeType length = elements.count();
+		const ElementType *source = elements.cbegin();
+		Vector<SizeType> order(length, 0);
+		for(SizeType i = 0; i < length; ++i)
+		{
+			order.set(i, i);
+		}
+		std::stable_sort(order.begin(), order.end(), [source](SizeType a, SizeType b)
+		{
+			return source[a].first < source[b].first;
+		});
+		
+		SizeType unique_count = 0;
+		for(SizeType i = 0; i < length; ++i)
+		{
+			if(i + 1 == length || source[order.get(i)].first < source[order.get(i + 1)].first)
+			{
+				++unique_count;
+			}
+		}
+		
+		m_keys = Vector<KeyType>(unique_count, KeyType());
+		m_values = Vector<ValueType>(unique_count, ValueType());
+		SizeType pos = 0;
+		for(SizeType i = 0; i < length; ++i)
+		{
+			if(i + 1 == length || source[order.get(i)].first < source[order.get(i + 1)].first)
+			{
+				m_keys.set(pos, source[order.get(i)].first);
+				m_values.set(pos, source[order.get(i)].second);
+				++pos;
+			}
+		}
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_keys.count();
+	}
+	
+	void clear()
+	{
+		m_keys.clear();
+		m_values.clear();
+	}
+	
+	bool contains(const KeyType &key) const
+	{
+		SizeType pos = lower_bound(key);
+		return pos < count() && !(key < m_keys.get(pos));
+	}
+	
+	ValueType &get(const KeyType &key)
+	{
+		return m_values.get(find_existing(key));
+	}
+	
+	const ValueType &get(const KeyType &key) const
+	{
+		return m_values.get(find_existing(key));
+	}
+	
+	void set(const KeyType &key, const ValueType &value)
+	{
+		SizeType pos = lower_bound(key);
+		if(pos < count() && !(key < m_keys.get(pos)))
+		{
+			m_values.set(pos, value);
+		}
+		else
+		{
+			m_keys.add(pos, key);
+			m_values.add(pos, value);
+		}
+	}
+	
+	void remove(const KeyType &key)
+	{
+		SizeType pos = find_existing(key);
+		m_keys.remove(pos);
+		m_values.remove(pos);
+	}
+	
+	// Position of the first key not less than the given one.
+	SizeType lower_bound(const KeyType &key) const
+	{
+		const KeyType *first = m_keys.cbegin();
+		const KeyType *base = first;
+		SizeType length = m_keys.count();
+		if(length == 0)
+		{
+			return 0;
+		}
+		while(length > 1)
+		{
+			SizeType half = length / 2;
+			// both possible midpoints of the next step, so the load is in flight before the compare resolves
+			__builtin_prefetch(base + half / 2);
+			__builtin_prefetch(base + half + half / 2);
+			base = (base[half] < key) ? base + half : base;
+			length -= half;
+		}
+		return (base - first) + (*base < key);
+	}
+	
+	// Position of the first key greater than the given one.
+	SizeType upper_bound(const KeyType &key) const
+	{
+		const KeyType *first = m_keys.cbegin();
+		const KeyType *base = first;
+		SizeType length = m_keys.count();
+		if(length == 0)
+		{
+			return 0;
+		}
+		while(length > 1)
+		{
+			SizeType half = length / 2;
+			__builtin_prefetch(base + half / 2);
+			__builtin_prefetch(base + half + half / 2);
+			base = (key < base[half]) ? base : base + half;
+			length -= half;
+		}
+		return (base - first) + !(key < *base);
+	}
+	
+	const KeyType &get_key(SizeType pos) const
+	{
+		return m_keys.get(pos);
+	}
+	
+	ValueType &get_value(SizeType pos)
+	{
+		return m_values.get(pos);
+	}
+	
+	const ValueType &get_value(SizeType pos) const
+	{
+		return m_values.get(pos);
+	}
+	
+	const Vector<KeyType> &keys() const noexcept
+	{
+		return m_keys;
+	}
+	
+	const Vector<ValueType> &values() const noexcept
+	{
+		return m_values;
+	}
+	
+private:
+	
+	SizeType find_existing(const KeyType &key) const
+	{
+		SizeType pos = lower_bound(key);
+		if(pos == count() || key < m_keys.get(pos))
+		{
+			throw std::out_of_range("");
+		}
+		return pos;
+	}
+};
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef FrozenHashMap_HPP
+#define FrozenHashMap_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "BitVector.hpp"
+#include "Vector.hpp"
+
+// Read-only hash map built once from a fixed set of elements. Construction finds a minimal perfect hash
+// with the hash-and-displace (CHD) scheme, so keys and values sit in two arrays exactly as long as
+// the element count and every lookup is a single probe followed by one key comparison.
+template<class Key, class Value, class HashFunc>
+class FrozenHashMap
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef Value ValueType;
+	typedef std::pair<Key, Value> ElementType;
+	typedef HashFunc HasherType;
+	
+	// average number of keys sharing one displacement; fewer means a bigger table but a faster build
+	static constexpr SizeType KEYS_PER_BUCKET = 3;
+	
+	// displacements tried for one bucket before the build reseeds; buckets with several keys are
+	// placed while at least about 5% of the slots are free, which takes a few thousand tries at most
+	static constexpr SizeType MAX_DISPLACEMENT_TRIES = SizeType(1) << 16;
+	
+	// seeds tried before the build gives up; one seed almost always suffices
+	static constexpr std::uint64_t MAX_SEEDS = 64;
+	
+private:
+	
+	struct Displacement
+	{
+		std::uint32_t multiplier, offset;
+	};
+	
+	struct KeyHashes
+	{
+		std::uint64_t bucket, first, second;
+	};
+	
+	Vector<KeyType> m_keys;
+	Vector<ValueType> m_values;
+	Vector<Displacement> m_displacements;
+	HasherType m_hasher;
+	std::uint64_t m_seed;
+	
+public:
+	
+	// When a key appears more than once, the last occurrence wins. Throws std::invalid_argument when
+	// two different keys hash equally, since no seed could then tell them apart.
+	FrozenHashMap(const HasherType &hash_function, const Vector<ElementType> &elements)
+		: m_keys(), m_values(), m_displacements(), m_hasher(hash_function), m_seed(0)
+	{
+		Vector<SizeType> unique = unique_elements(elements);
+		SizeType length = unique.count();
+		if(length == 0)
+		{
+			return;
+		}
+		if(length > 0xFFFFFFFFu)
+		{
+			throw std::length_error("");
+		}
+		Vector<SizeType> slots(length, 0);
+		while(!try_build(elements, unique, slots))
+		{
+			if(++m_seed == MAX_SEEDS)
+			{
+				throw std::invalid_argument("");
+			}
+		}
+		m_keys = Vector<KeyType>(length, KeyType());
+		m_values = Vector<ValueType>(length, ValueType());
+		for(SizeType i = 0; i < length; ++i)
+		{
+			m_keys.set(slots.get(i), elements.get(unique.get(i)).first);
+			m_values.set(slots.get(i), elements.get(unique.get(i)).second);
+		}
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_keys.count();
+	}
+	
+	bool contains(const KeyType &key) const
+	{
+		return count() > 0 && m_keys.get(slot_of(key)) == key;
+	}
+	
+	const ValueType &get(const KeyType &key) const
+	{
+		SizeType slot = count() > 0 ? slot_of(key) : 0;
+		if(count() == 0 || !(m_keys.get(slot) == key))
+		{
+			throw std::out_of_range("");
+		}
+		return m_values.get(slot);
+	}
+	
+	ValueType &get(const KeyType &key)
+	{
+		return const_cast<ValueType &>(static_cast<const FrozenHashMap *>(this) -> get(key));
+	}
+	
+	// Keys and values in slot order; the key at some position belongs to the value at the same position.
+	const Vector<KeyType> &keys() const noexcept
+	{
+		return m_keys;
+	}
+	
+	const Vector<ValueType> &values() const noexcept
+	{
+		return m_values;
+	}
+	
+private:
+	
+	static std::uint64_t mix(std::uint64_t x) noexcept
+	{
+		x ^= x >> 30;
+		x *= 0xBF58476D1CE4E5B9ull;
+		x ^= x >> 27;
+		x *= 0x94D049BB133111EBull;
+		x ^= x >> 31;
+		return x;
+	}
+	
+	KeyHashes hashes_of(const KeyType &key, SizeType length) const
+	{
+		std::uint64_t first = mix(static_cast<std::uint64_t>(m_hasher(key)) ^ m_seed);
+		std::uint64_t second = mix(first + 0x9E3779B97F4A7C15ull);
+		std::uint64_t third = mix(second + 0x9E3779B97F4A7C15ull);
+		SizeType bucket_count = (length + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET;
+		return KeyHashes{ .bucket = first % bucket_count, .first = second % length, .second = third % length };
+	}
+	
+	static SizeType displaced(const KeyHashes &hashes, const Displacement &displacement, SizeType length) noexcept
+	{
+		return (hashes.first + displacement.multiplier * hashes.second + displacement.offset) % length;
+	}
+	
+	SizeType slot_of(const KeyType &key) const
+	{
+		KeyHashes hashes = hashes_of(key, count());
+		return displaced(hashes, m_displacements.get(hashes.bucket), count());
+	}
+	
+	// Indices of the elements that survive deduplication. Equal keys hash equally, so sorting
+	// by hash puts duplicates next to each other; a run of equal hashes holding different keys is rejected.
+	Vector<SizeType> unique_elements(const Vector<ElementType> &elements) const
+	{
+		SizeType length = elements.count();
+		Vector<std::uint64_t> hashes(length, 0);
+		Vector<SizeType> order(length, 0);
+		for(SizeType i = 0; i < length; ++i)
+		{
+			hashes.set(i, static_cast<std::uint64_t>(m_hasher(elements.get(i).first)));
+			order.set(i, i);
+		}
+		std::stable_sort(order.begin(), order.end(), [&hashes](SizeType a, SizeType b)
+		{
+			return hashes.get(a) < hashes.get(b);
+		});
+		
+		BitVector duplicate(length, false);
+		for(SizeType run = 0; run < length; )
+		{
+			SizeType run_end = run + 1;
+			while(run_end < length && hashes.get(order.get(run_end)) == hashes.get(order.get(run)))
+			{
+				++run_end;
+			}
+			// the run holds a single key, and the stable sort keeps its last occurrence at the end
+			for(SizeType i = run; i + 1 < run_end; ++i)
+			{
+				if(!(elements.get(order.get(i)).first == elements.get(order.get(run_end - 1)).first))
+				{
+					throw std::invalid_argument("");
+				}
+				duplicate.set(order.get(i), true);
+			}
+			run = run_end;
+		}
+		
+		Vector<SizeType> unique(length - duplicate.count_ones(), 0);
+		for(SizeType i = 0, pos = 0; i < length; ++i)
+		{
+			if(!duplicate.get(i))
+			{
+				unique.set(pos++, i);
+			}
+		}
+		return unique;
+	}
+	
+	// Places the biggest buckets first, trying displacements until all of a bucket's keys land
+	// on free slots. Gives up when some bucket cannot be placed, so the caller can reseed. A bucket
+	// costs at most MAX_DISPLACEMENT_TRIES tries of its few keys, so one attempt is O(n) bounded.
+	bool try_build(const Vector<ElementType> &elements, const Vector<SizeType> &unique, Vector<SizeType> &slots)
+	{
+		SizeType length = unique.count();
+		SizeType bucket_count = (length + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET;
+		Vector<KeyHashes> hashes(length, KeyHashes());
+		Vector<SizeType> bucket_starts(bucket_count + 1, 0);
+		for(SizeType i = 0; i < length; ++i)
+		{
+			hashes.set(i, hashes_of(elements.get(unique.get(i)).first, length));
+			++bucket_starts.get(hashes.get(i).bucket + 1);
+		}
+		for(SizeType b = 0; b < bucket_count; ++b)
+		{
+			bucket_starts.get(b + 1) += bucket_starts.get(b);
+		}
+		Vector<SizeType> bucket_members(length, 0);
+		Vector<SizeType> fill(bucket_starts);
+		for(SizeType i = 0; i < length; ++i)
+		{
+			bucket_members.set(fill.get(hashes.get(i).bucket)++, i);
+		}
+		
+		Vector<SizeType> bucket_order(bucket_count, 0);
+		for(SizeType b = 0; b < bucket_count; ++b)
+		{
+			bucket_order.set(b, b);
+		}
+		std::stable_sort(bucket_order.begin(), bucket_order.end(), [&bucket_starts](SizeType a, SizeType b)
+		{
+			return bucket_starts.get(a + 1) - bucket_starts.get(a) > bucket_starts.get(b + 1) - bucket_starts.get(b);
+		});
+		
+		m_displacements = Vector<Displacement>(bucket_count, Displacement{ .multiplier = 0, .offset = 0 });
+		BitVector free_slots(length, true);
+		SizeType next_free = 0;
+		for(SizeType b : bucket_order)
+		{
+			SizeType first_member = bucket_starts.get(b), end_member = bucket_starts.get(b + 1);
+			if(first_member == end_member)
+			{
+				break;
+			}
+			if(end_member - first_member == 1)
+			{
+				// lone keys come last and each one goes straight to the lowest free slot
+				if(!free_slots.get(next_free))
+				{
+					next_free = free_slots.find_next(next_free);
+				}
+				SizeType member = bucket_members.get(first_member);
+				std::uint32_t offset = static_cast<std::uint32_t>((next_free + length - hashes.get(member).first) % length);
+				m_displacements.set(b, Displacement{ .multiplier = 0, .offset = offset });
+				free_slots.set(next_free, false);
+				slots.set(member, next_free);
+			}
+			else if(!place_bucket(hashes, bucket_members, first_member, end_member, free_slots, m_displacements.get(b), slots))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	
+	static bool place_bucket(const Vector<KeyHashes> &hashes, const Vector<SizeType> &bucket_members,
+		SizeType first_member, SizeType end_member, BitVector &free_slots, Displacement &displacement, Vector<SizeType> &slots)
+	{
+		SizeType length = hashes.count();
+		SizeType tries = length * length < MAX_DISPLACEMENT_TRIES ? length * length : MAX_DISPLACEMENT_TRIES;
+		for(SizeType attempt = 0; attempt < tries; ++attempt)
+		{
+			// both change on every try: the offset alone cannot separate keys of the bucket that share
+			// their first hash, and the multiplier alone reaches few slots when it shares factors with length
+			displacement = Displacement{ .multiplier = static_cast<std::uint32_t>(attempt % length), .offset = static_cast<std::uint32_t>(mix(attempt) % length) };
+			SizeType placed = first_member;
+			for(; placed < end_member; ++placed)
+			{
+				SizeType member = bucket_members.get(placed);
+				SizeType slot = displaced(hashes.get(member), displacement, length);
+				if(!free_slots.get(slot))
+				{
+					break;
+				}
+				free_slots.set(slot, false);
+				slots.set(member, slot);
+			}
+			if(placed == end_member)
+			{
+				return true;
+			}
+			for(SizeType i = first_member; i < placed; ++i)
+			{
+				free_slots.set(slots.get(bucket_members.get(i)), true);
+			}
+		}
+		return false;
+	}
+};
+
+#endif
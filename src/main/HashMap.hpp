@@ -2,14 +2,26 @@
 #define HashMap_HPP
 
 #include <cstddef>
+#include <span>
+#include <stdexcept>
 #include <utility>
 
-#include "LinkedList.hpp"
+#include "HashTable.hpp"
 #include "Vector.hpp"
 
 template<class Key, class Value, class HashFunc>
 class HashMap
 {
+	struct PairKey
+	{
+		static const Key &get(const std::pair<Key, Value> &element) noexcept
+		{
+			return element.first;
+		}
+	};
+	
+	typedef HashTable<Key, std::pair<Key, Value>, PairKey, HashFunc> TableType;
+	
 public:
 	
 	typedef std::size_t SizeType;
@@ -17,29 +29,156 @@ public:
 	typedef Value ValueType;
 	typedef std::pair<Key, Value> ElementType;
 	typedef HashFunc HasherType;
+	typedef typename TableType::IteratorType IteratorType;
+	typedef typename TableType::ConstIteratorType ConstIteratorType;
+	
+	// how many keys get_many and contains_many hash and prefetch before resolving any of them
+	static constexpr SizeType LOOKUP_BATCH = TableType::LOOKUP_BATCH;
+	
+	// the bulk build gives every thread at least this many elements
+	static constexpr SizeType BUILD_ELEMENTS_PER_THREAD = TableType::BUILD_ELEMENTS_PER_THREAD;
 	
 private:
 	
-	Vector<LinkedList<ElementType>> m_buckets;
-	HasherType m_hasher;
-	float m_max_load_factor;
-
+	TableType m_table;
+	
 public:
 	
-	HashMap(const HasherType &hash_function, SizeType initial_bucket_count = 10, float max_load_factor = 0.75f)
-		: m_buckets(initial_bucket_count),
-		m_hasher(hash_function),
-		m_max_load_factor(max_load_factor)
+	HashMap(const HasherType &hash_function = HasherType(), SizeType initial_bucket_count = 10, float max_load_factor = 0.75f)
+		: m_table(hash_function, initial_bucket_count, max_load_factor)
+	{}
+	
+	// Bulk build sized once for all the elements, without rehashing, and spread over thread_count
+	// threads (all hardware threads when 0); see HashTable. The hasher has to be safe to call
+	// concurrently. When a key appears more than once, the last occurrence wins.
+	HashMap(const Vector<ElementType> &elements, const HasherType &hash_function = HasherType(), float max_load_factor = 0.75f, SizeType thread_count = 0)
+		: m_table(elements, hash_function, max_load_factor, thread_count)
+	{}
+	
+	SizeType count() const noexcept
+	{
+		return m_table.count();
+	}
+	
+	SizeType bucket_count() const noexcept
 	{
-		for(auto &bucket : m_buckets)
+		return m_table.bucket_count();
+	}
+	
+	bool contains(const KeyType &key) const
+	{
+		return m_table.find(key) != nullptr;
+	}
+	
+	const ValueType &get(const KeyType &key) const
+	{
+		const ElementType *element = m_table.find(key);
+		if(element == nullptr)
 		{
-			bucket = LinkedList<ElementType>();
+			throw std::out_of_range("");
 		}
+		return element -> second;
+	}
+	
+	ValueType &get(const KeyType &key)
+	{
+		return const_cast<ValueType &>(static_cast<const HashMap *>(this) -> get(key));
+	}
+	
+	// Inserts the key, or overwrites its value when it is already present.
+	void set(const KeyType &key, const ValueType &value)
+	{
+		ElementType *element = m_table.find(key);
+		if(element != nullptr)
+		{
+			element -> second = value;
+			return;
+		}
+		m_table.insert(ElementType(key, value));
+	}
+	
+	void remove(const KeyType &key)
+	{
+		if(!m_table.remove(key))
+		{
+			throw std::out_of_range("");
+		}
+	}
+	
+	void clear()
+	{
+		m_table.clear();
+	}
+	
+	// Iteration goes bucket by bucket, so the order is unspecified and changes on rehash.
+	IteratorType begin() noexcept
+	{
+		return m_table.begin();
+	}
+	
+	ConstIteratorType cbegin() const noexcept
+	{
+		return m_table.cbegin();
+	}
+	
+	IteratorType end() noexcept
+	{
+		return m_table.end();
+	}
+	
+	ConstIteratorType cend() const noexcept
+	{
+		return m_table.cend();
+	}
+	
+	// Batched lookups: values[i] is set to the value of keys[i], or to nullptr when that key is missing.
+	// All keys of a batch are hashed and their buckets prefetched before any chain is walked,
+	// so the cache misses of different keys overlap instead of being paid one after another.
+	void get_many(std::span<const KeyType> keys, std::span<const ValueType *> values) const
+	{
+		if(keys.size() != values.size())
+		{
+			throw std::invalid_argument("");
+		}
+		m_table.lookup_many(keys.size(), key_at(keys), [&values](SizeType i, const ElementType *element)
+		{
+			values[i] = element == nullptr ? nullptr : &element -> second;
+		});
+	}
+	
+	void get_many(std::span<const KeyType> keys, std::span<ValueType *> values)
+	{
+		if(keys.size() != values.size())
+		{
+			throw std::invalid_argument("");
+		}
+		m_table.lookup_many(keys.size(), key_at(keys), [&values](SizeType i, const ElementType *element)
+		{
+			values[i] = element == nullptr ? nullptr : const_cast<ValueType *>(&element -> second);
+		});
+	}
+	
+	void contains_many(std::span<const KeyType> keys, std::span<bool> found) const
+	{
+		if(keys.size() != found.size())
+		{
+			throw std::invalid_argument("");
+		}
+		m_table.lookup_many(keys.size(), key_at(keys), [&found](SizeType i, const ElementType *element)
+		{
+			found[i] = element != nullptr;
+		});
 	}
 	
 private:
 	
-	//void rehash()
+	static auto key_at(std::span<const KeyType> keys) noexcept
+	{
+		return [keys](SizeType i) -> const KeyType &
+		{
+			return keys[i];
+		};
+	}
 };
 
 #endif
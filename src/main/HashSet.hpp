@@ -0,0 +1,463 @@
+#ifndef HashSet_HPP
+#define HashSet_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "HashTable.hpp"
+#include "Vector.hpp"
+
+// Set of keys on the same chained table as HashMap, storing only the keys. The set operations
+// walk the smaller operand and probe the other one LOOKUP_BATCH keys at a time, like get_many.
+template<class Key, class HashFunc>
+class HashSet
+{
+	struct SelfKey
+	{
+		static const Key &get(const Key &key) noexcept
+		{
+			return key;
+		}
+	};
+	
+	typedef HashTable<Key, Key, SelfKey, HashFunc> TableType;
+	
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef Key ElementType;
+	typedef HashFunc HasherType;
+	// keys cannot be changed in place, as that would move them to another bucket
+	typedef typename TableType::ConstIteratorType IteratorType;
+	typedef typename TableType::ConstIteratorType ConstIteratorType;
+	
+	static constexpr SizeType LOOKUP_BATCH = TableType::LOOKUP_BATCH;
+	
+private:
+	
+	TableType m_table;
+	
+public:
+	
+	HashSet(const HasherType &hash_function = HasherType(), SizeType initial_bucket_count = 10, float max_load_factor = 0.75f)
+		: m_table(hash_function, initial_bucket_count, max_load_factor)
+	{}
+	
+	// Bulk build, as for HashMap; duplicate keys are stored once.
+	HashSet(const Vector<KeyType> &keys, const HasherType &hash_function = HasherType(), float max_load_factor = 0.75f, SizeType thread_count = 0)
+		: m_table(keys, hash_function, max_load_factor, thread_count)
+	{}
+	
+	SizeType count() const noexcept
+	{
+		return m_table.count();
+	}
+	
+	SizeType bucket_count() const noexcept
+	{
+		return m_table.bucket_count();
+	}
+	
+	bool contains(const KeyType &key) const
+	{
+		return m_table.find(key) != nullptr;
+	}
+	
+	// Returns false when the key was already present.
+	bool add(const KeyType &key)
+	{
+		return m_table.insert(key).second;
+	}
+	
+	void remove(const KeyType &key)
+	{
+		if(!m_table.remove(key))
+		{
+			throw std::out_of_range("");
+		}
+	}
+	
+	void clear()
+	{
+		m_table.clear();
+	}
+	
+	IteratorType begin() const noexcept
+	{
+		return m_table.cbegin();
+	}
+	
+	ConstIteratorType cbegin() const noexcept
+	{
+		return m_table.cbegin();
+	}
+	
+	IteratorType end() const noexcept
+	{
+		return m_table.cend();
+	}
+	
+	ConstIteratorType cend() const noexcept
+	{
+		return m_table.cend();
+	}
+	
+	// found[i] is set to whether keys[i] is in the set.
+	void contains_many(std::span<const KeyType> keys, std::span<bool> found) const
+	{
+		if(keys.size() != found.size())
+		{
+			throw std::invalid_argument("");
+		}
+		m_table.lookup_many(keys.size(), [keys](SizeType i) -> const KeyType &
+		{
+			return keys[i];
+		}, [&found](SizeType i, const KeyType *key)
+		{
+			found[i] = key != nullptr;
+		});
+	}
+	
+	// Copies the larger set and adds the keys of the smaller one.
+	HashSet set_union(const HashSet &other) const
+	{
+		const HashSet &larger = count() >= other.count() ? *this : other;
+		const HashSet &smaller = count() >= other.count() ? other : *this;
+		HashSet result = larger;
+		result.m_table.reserve(larger.count() + smaller.count());
+		for(const KeyType &key : smaller)
+		{
+			result.m_table.insert(key);
+		}
+		return result;
+	}
+	
+	HashSet set_intersection(const HashSet &other) const
+	{
+		const HashSet &larger = count() >= other.count() ? *this : other;
+		const HashSet &smaller = count() >= other.count() ? other : *this;
+		HashSet result(m_table.hasher(), SizeType(smaller.count() / m_table.max_load_factor()) + 1, m_table.max_load_factor());
+		smaller.probe(larger, [&result](const KeyType &key, bool found)
+		{
+			if(found)
+			{
+				result.m_table.insert(key);
+			}
+			return true;
+		});
+		return result;
+	}
+	
+	SizeType intersection_count(const HashSet &other) const
+	{
+		const HashSet &larger = count() >= other.count() ? *this : other;
+		const HashSet &smaller = count() >= other.count() ? other : *this;
+		SizeType length = 0;
+		smaller.probe(larger, [&length](const KeyType &, bool found)
+		{
+			length += found;
+			return true;
+		});
+		return length;
+	}
+	
+	// The keys of this set that are not in other. When other is the smaller one, this set is
+	// copied and the keys of other are removed from it instead.
+	HashSet set_difference(const HashSet &other) const
+	{
+		if(other.count() < count())
+		{
+			HashSet result = *this;
+			for(const KeyType &key : other)
+			{
+				result.m_table.remove(key);
+			}
+			return result;
+		}
+		HashSet result(m_table.hasher(), SizeType(count() / m_table.max_load_factor()) + 1, m_table.max_load_factor());
+		probe(other, [&result](const KeyType &key, bool found)
+		{
+			if(!found)
+			{
+				result.m_table.insert(key);
+			}
+			return true;
+		});
+		return result;
+	}
+	
+	// Stops probing at the first key of this set that other lacks.
+	bool is_subset_of(const HashSet &other) const
+	{
+		if(count() > other.count())
+		{
+			return false;
+		}
+		bool subset = true;
+		probe(other, [&subset](const KeyType &, bool found)
+		{
+			subset = found;
+			return found;
+		});
+		return subset;
+	}
+	
+private:
+	
+	// Calls visit(key, whether other contains it) for every key of this set, gathering the keys
+	// LOOKUP_BATCH at a time so that other can prefetch their buckets together. visit returns false to stop.
+	template<class Visit>
+	void probe(const HashSet &other, Visit visit) const
+	{
+		const KeyType *batch[LOOKUP_BATCH];
+		bool found[LOOKUP_BATCH];
+		SizeType length = 0;
+		auto flush = [&]
+		{
+			other.m_table.lookup_many(length, [&batch](SizeType i) -> const KeyType &
+			{
+				return *batch[i];
+			}, [&found](SizeType i, const KeyType *key)
+			{
+				found[i] = key != nullptr;
+			});
+			for(SizeType i = 0; i < length; ++i)
+			{
+				if(!visit(*batch[i], found[i]))
+				{
+					return false;
+				}
+			}
+			length = 0;
+			return true;
+		};
+		for(const KeyType &key : *this)
+		{
+			batch[length++] = &key;
+			if(length == LOOKUP_BATCH && !flush())
+			{
+				return;
+			}
+		}
+		flush();
+	}
+};
+
+// Set of integers kept as a sorted Vector, for when sets are built once and then mostly
+// intersected. Intersection merges the two arrays a vector register at a time: each block of
+// LANES elements of one side is compared against every element of a block of the other side,
+// and whichever block ends lower is stepped past. When one side is much smaller, each of its
+// elements is found in the other by galloping instead.
+template<class Int = std::uint32_t>
+class SortedIntegerSet
+{
+	static_assert(std::is_integral_v<Int>);
+	
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Int ElementType;
+	typedef const ElementType *IteratorType;
+	typedef const ElementType *ConstIteratorType;
+	
+	static constexpr SizeType VECTOR_BYTES = 16;
+	static constexpr SizeType LANES = VECTOR_BYTES / sizeof(ElementType);
+	
+	// a size ratio beyond which galloping through the larger set beats merging
+	static constexpr SizeType GALLOP_RATIO = 32;
+	
+private:
+	
+	typedef ElementType Lanes __attribute__((vector_size(VECTOR_BYTES)));
+	
+	Vector<ElementType> m_elements;
+	
+public:
+	
+	SortedIntegerSet()
+		: m_elements(0)
+	{}
+	
+	// Sorts the elements and drops the duplicates.
+	SortedIntegerSet(const Vector<ElementType> &elements)
+		: m_elements(0)
+	{
+		if(elements.count() == 0)
+		{
+			return;
+		}
+		Vector<ElementType> sorted(elements);
+		std::sort(sorted.begin(), sorted.end());
+		SizeType length = std::unique(sorted.begin(), sorted.end()) - sorted.begin();
+		m_elements = copy_prefix(sorted.cbegin(), length);
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_elements.count();
+	}
+	
+	bool contains(ElementType value) const
+	{
+		return std::binary_search(m_elements.cbegin(), m_elements.cend(), value);
+	}
+	
+	// The elements in ascending order.
+	ElementType get(SizeType pos) const
+	{
+		return m_elements.get(pos);
+	}
+	
+	ConstIteratorType begin() const noexcept
+	{
+		return m_elements.cbegin();
+	}
+	
+	ConstIteratorType cbegin() const noexcept
+	{
+		return m_elements.cbegin();
+	}
+	
+	ConstIteratorType end() const noexcept
+	{
+		return m_elements.cend();
+	}
+	
+	ConstIteratorType cend() const noexcept
+	{
+		return m_elements.cend();
+	}
+	
+	SortedIntegerSet set_intersection(const SortedIntegerSet &other) const
+	{
+		SizeType limit = count() < other.count() ? count() : other.count();
+		SortedIntegerSet result;
+		if(limit == 0)
+		{
+			return result;
+		}
+		Vector<ElementType> scratch(limit, ElementType());
+		SizeType length = intersect(other, scratch.begin());
+		result.m_elements = copy_prefix(scratch.cbegin(), length);
+		return result;
+	}
+	
+	SizeType intersection_count(const SortedIntegerSet &other) const
+	{
+		return intersect(other, nullptr);
+	}
+	
+private:
+	
+	static Vector<ElementType> copy_prefix(const ElementType *elements, SizeType length)
+	{
+		Vector<ElementType> copy(length, ElementType());
+		std::copy(elements, elements + length, copy.begin());
+		return copy;
+	}
+	
+	// Writes the common elements to out unless it is nullptr, and returns how many there are.
+	SizeType intersect(const SortedIntegerSet &other, ElementType *out) const
+	{
+		const ElementType *a = m_elements.cbegin(), *b = other.m_elements.cbegin();
+		SizeType a_length = count(), b_length = other.count();
+		if(a_length > b_length)
+		{
+			std::swap(a, b);
+			std::swap(a_length, b_length);
+		}
+		if(a_length * GALLOP_RATIO < b_length)
+		{
+			return intersect_galloping(a, a_length, b, b_length, out);
+		}
+		return intersect_merging(a, a_length, b, b_length, out);
+	}
+	
+	static SizeType intersect_merging(const ElementType *a, SizeType a_length, const ElementType *b, SizeType b_length, ElementType *out)
+	{
+		SizeType i = 0, j = 0, length = 0;
+		while(i + LANES <= a_length && j + LANES <= b_length)
+		{
+			Lanes block;
+			__builtin_memcpy(&block, a + i, sizeof(Lanes));
+			// all ones in the lanes of block that equal some element of b's block
+			auto matches = block != block;
+			for(SizeType k = 0; k < LANES; ++k)
+			{
+				matches |= block == (Lanes{} + b[j + k]);
+			}
+			for(SizeType k = 0; k < LANES; ++k)
+			{
+				if(matches[k] != 0)
+				{
+					if(out != nullptr)
+					{
+						out[length] = a[i + k];
+					}
+					++length;
+				}
+			}
+			ElementType a_last = a[i + LANES - 1], b_last = b[j + LANES - 1];
+			i += a_last <= b_last ? LANES : 0;
+			j += b_last <= a_last ? LANES : 0;
+		}
+		// the rest one element at a time
+		while(i < a_length && j < b_length)
+		{
+			if(a[i] < b[j])
+			{
+				++i;
+			}
+			else if(b[j] < a[i])
+			{
+				++j;
+			}
+			else
+			{
+				if(out != nullptr)
+				{
+					out[length] = a[i];
+				}
+				++length;
+				++i;
+				++j;
+			}
+		}
+		return length;
+	}
+	
+	// For each element of the small side, doubles a step through the large side until it passes the
+	// element, then binary searches the last step. Both sides only move forward.
+	static SizeType intersect_galloping(const ElementType *a, SizeType a_length, const ElementType *b, SizeType b_length, ElementType *out)
+	{
+		SizeType j = 0, length = 0;
+		for(SizeType i = 0; i < a_length && j < b_length; ++i)
+		{
+			SizeType step = 1;
+			while(j + step < b_length && b[j + step] < a[i])
+			{
+				step *= 2;
+			}
+			SizeType last = j + step < b_length ? j + step + 1 : b_length;
+			j = std::lower_bound(b + j, b + last, a[i]) - b;
+			if(j < b_length && b[j] == a[i])
+			{
+				if(out != nullptr)
+				{
+					out[length] = a[i];
+				}
+				++length;
+				++j;
+			}
+		}
+		return length;
+	}
+};
+
+#endif
@@ -0,0 +1,429 @@
+#ifndef HashTable_HPP
+#define HashTable_HPP
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "LinkedList.hpp"
+#include "Vector.hpp"
+
+// The chained table behind HashMap and HashSet. Elements are stored whole and KeyOf::get(element)
+// gives the key of an element, so a map stores key-value pairs and a set stores bare keys.
+template<class Key, class Elem, class KeyOf, class HashFunc>
+class HashTable
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef Elem ElementType;
+	typedef HashFunc HasherType;
+	
+	// how many keys lookup_many hashes and prefetches before resolving any of them
+	static constexpr SizeType LOOKUP_BATCH = 32;
+	
+	// the bulk build gives every thread at least this many elements
+	static constexpr SizeType BUILD_ELEMENTS_PER_THREAD = SizeType(1) << 15;
+	
+private:
+	
+	typedef LinkedList<ElementType> BucketType;
+	
+	template<class Pointee>
+	class HashTableIterator;
+	
+public:
+	
+	typedef HashTableIterator<ElementType> IteratorType;
+	typedef HashTableIterator<const ElementType> ConstIteratorType;
+	
+private:
+	
+	Vector<BucketType> m_buckets;
+	HasherType m_hasher;
+	float m_max_load_factor;
+	SizeType m_length;
+	
+public:
+	
+	HashTable(const HasherType &hash_function, SizeType initial_bucket_count, float max_load_factor)
+		: m_buckets(initial_bucket_count == 0 ? 1 : initial_bucket_count, BucketType()),
+		m_hasher(hash_function),
+		m_max_load_factor(max_load_factor),
+		m_length(0)
+	{}
+	
+	// Bulk build sized once for all the elements, without rehashing. The buckets are split into
+	// one contiguous range per thread and the elements are radix-partitioned by the range their
+	// hash falls into, so every thread fills its own part of the table without locking.
+	// A thread_count of 0 uses all hardware threads; the hasher has to be safe to call concurrently.
+	// When a key appears more than once, the last occurrence wins.
+	HashTable(const Vector<ElementType> &elements, const HasherType &hash_function, float max_load_factor, SizeType thread_count)
+		: m_buckets(SizeType(elements.count() / max_load_factor) + 1, BucketType()),
+		m_hasher(hash_function),
+		m_max_load_factor(max_load_factor),
+		m_length(0)
+	{
+		SizeType length = elements.count();
+		SizeType threads = build_thread_count(length, thread_count);
+		
+		// hash every element and count how many each thread sends to each partition
+		Vector<SizeType> buckets(length, 0);
+		Vector<SizeType> partition_starts(threads * threads + 1, 0);
+		parallel_for(threads, [&](SizeType thread)
+		{
+			for(SizeType i = length * thread / threads; i < length * (thread + 1) / threads; ++i)
+			{
+				buckets.set(i, bucket_of(KeyOf::get(elements.get(i))));
+				++partition_starts.get(partition_of(buckets.get(i), threads) * threads + thread + 1);
+			}
+		});
+		for(SizeType i = 0; i < threads * threads; ++i)
+		{
+			partition_starts.get(i + 1) += partition_starts.get(i);
+		}
+		
+		// scatter element indices partition by partition, keeping the input order within each one
+		Vector<SizeType> order(length, 0);
+		Vector<SizeType> cursors(partition_starts);
+		parallel_for(threads, [&](SizeType thread)
+		{
+			for(SizeType i = length * thread / threads; i < length * (thread + 1) / threads; ++i)
+			{
+				order.set(cursors.get(partition_of(buckets.get(i), threads) * threads + thread)++, i);
+			}
+		});
+		
+		Vector<SizeType> inserted(threads, 0);
+		parallel_for(threads, [&](SizeType partition)
+		{
+			for(SizeType pos = partition_starts.get(partition * threads); pos < partition_starts.get((partition + 1) * threads); ++pos)
+			{
+				const ElementType &element = elements.get(order.get(pos));
+				BucketType &bucket = m_buckets.get(buckets.get(order.get(pos)));
+				ElementType *existing = const_cast<ElementType *>(find(bucket, KeyOf::get(element)));
+				if(existing != nullptr)
+				{
+					*existing = element;
+				}
+				else
+				{
+					bucket.add_back(element);
+					++inserted.get(partition);
+				}
+			}
+		});
+		for(SizeType partition_length : inserted)
+		{
+			m_length += partition_length;
+		}
+	}
+	
+	HashTable(const HashTable &other) = default;
+	
+	// Leaves other empty but still with one bucket, since bucket_of divides by the bucket count.
+	HashTable(HashTable &&other)
+		: m_buckets(std::move(other.m_buckets)),
+		m_hasher(other.m_hasher),
+		m_max_load_factor(other.m_max_load_factor),
+		m_length(other.m_length)
+	{
+		other.m_buckets = Vector<BucketType>(1, BucketType());
+		other.m_length = 0;
+	}
+	
+	HashTable &operator=(HashTable other)
+	{
+		std::swap(m_buckets, other.m_buckets);
+		std::swap(m_hasher, other.m_hasher);
+		std::swap(m_max_load_factor, other.m_max_load_factor);
+		std::swap(m_length, other.m_length);
+		return *this;
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	SizeType bucket_count() const noexcept
+	{
+		return m_buckets.count();
+	}
+	
+	float max_load_factor() const noexcept
+	{
+		return m_max_load_factor;
+	}
+	
+	const HasherType &hasher() const noexcept
+	{
+		return m_hasher;
+	}
+	
+	// Gives nullptr when the key is missing.
+	const ElementType *find(const KeyType &key) const
+	{
+		return find(m_buckets.get(bucket_of(key)), key);
+	}
+	
+	ElementType *find(const KeyType &key)
+	{
+		return const_cast<ElementType *>(find(m_buckets.get(bucket_of(key)), key));
+	}
+	
+	// Inserts the element unless its key is already present. Either way, gives the element stored
+	// under the key, and whether it was inserted.
+	std::pair<ElementType *, bool> insert(const ElementType &element)
+	{
+		ElementType *existing = find(KeyOf::get(element));
+		if(existing != nullptr)
+		{
+			return std::pair<ElementType *, bool>(existing, false);
+		}
+		// grow first, so that the element is not copied by the rehash
+		if(m_length + 1 > m_max_load_factor * m_buckets.count())
+		{
+			rehash(m_buckets.count() * 2);
+		}
+		BucketType &bucket = m_buckets.get(bucket_of(KeyOf::get(element)));
+		bucket.add_back(element);
+		++m_length;
+		return std::pair<ElementType *, bool>(&*bucket.rbegin(), true);
+	}
+	
+	// Returns false when the key is missing.
+	bool remove(const KeyType &key)
+	{
+		BucketType &bucket = m_buckets.get(bucket_of(key));
+		for(auto it = bucket.begin(); it != bucket.end(); ++it)
+		{
+			if(KeyOf::get(*it) == key)
+			{
+				bucket.remove(it);
+				--m_length;
+				return true;
+			}
+		}
+		return false;
+	}
+	
+	// Grows the table so that it holds length elements without rehashing again.
+	void reserve(SizeType length)
+	{
+		SizeType needed = SizeType(length / m_max_load_factor) + 1;
+		if(needed > m_buckets.count())
+		{
+			rehash(needed);
+		}
+	}
+	
+	void clear()
+	{
+		m_buckets = Vector<BucketType>(m_buckets.count(), BucketType());
+		m_length = 0;
+	}
+	
+	// Iteration goes bucket by bucket, so the order is unspecified and changes on rehash.
+	IteratorType begin() noexcept
+	{
+		return IteratorType(m_buckets.cbegin(), m_buckets.cend());
+	}
+	
+	ConstIteratorType cbegin() const noexcept
+	{
+		return ConstIteratorType(m_buckets.cbegin(), m_buckets.cend());
+	}
+	
+	IteratorType end() noexcept
+	{
+		return IteratorType(m_buckets.cend(), m_buckets.cend());
+	}
+	
+	ConstIteratorType cend() const noexcept
+	{
+		return ConstIteratorType(m_buckets.cend(), m_buckets.cend());
+	}
+	
+	// Looks up key_at(0) .. key_at(length - 1) and calls found(i, element) for each of them, with
+	// nullptr when the key is missing. Three passes per batch: hash and prefetch the bucket headers,
+	// then prefetch the first link of every chain (the headers are cached by now), then compare keys,
+	// so the cache misses of different keys overlap instead of being paid one after another.
+	template<class KeyAt, class Found>
+	void lookup_many(SizeType length, KeyAt key_at, Found found) const
+	{
+		SizeType buckets[LOOKUP_BATCH];
+		for(SizeType first = 0; first < length; first += LOOKUP_BATCH)
+		{
+			SizeType batch = length - first < LOOKUP_BATCH ? length - first : LOOKUP_BATCH;
+			for(SizeType i = 0; i < batch; ++i)
+			{
+				buckets[i] = bucket_of(key_at(first + i));
+				__builtin_prefetch(m_buckets.cbegin() + buckets[i]);
+			}
+			for(SizeType i = 0; i < batch; ++i)
+			{
+				const BucketType &bucket = m_buckets.get(buckets[i]);
+				if(bucket.count() > 0)
+				{
+					__builtin_prefetch(&*bucket.cbegin());
+				}
+			}
+			for(SizeType i = 0; i < batch; ++i)
+			{
+				found(first + i, find(m_buckets.get(buckets[i]), key_at(first + i)));
+			}
+		}
+	}
+	
+private:
+	
+	SizeType bucket_of(const KeyType &key) const
+	{
+		return static_cast<SizeType>(m_hasher(key)) % m_buckets.count();
+	}
+	
+	SizeType partition_of(SizeType bucket, SizeType partitions) const noexcept
+	{
+		return bucket * partitions / m_buckets.count();
+	}
+	
+	static SizeType build_thread_count(SizeType length, SizeType requested)
+	{
+		SizeType threads = requested != 0 ? requested : std::thread::hardware_concurrency();
+		SizeType useful = length / BUILD_ELEMENTS_PER_THREAD;
+		threads = threads < useful ? threads : useful;
+		return threads == 0 ? 1 : threads;
+	}
+	
+	// Runs func(0) .. func(threads - 1) on as many threads, one of them the calling thread,
+	// and rethrows the first exception any of them threw.
+	template<class Func>
+	static void parallel_for(SizeType threads, Func func)
+	{
+		std::unique_ptr<std::thread[]> workers(new std::thread[threads]);
+		Vector<std::exception_ptr> errors(threads, nullptr);
+		for(SizeType thread = 1; thread < threads; ++thread)
+		{
+			workers[thread] = std::thread([&func, &errors, thread]
+			{
+				try
+				{
+					func(thread);
+				}
+				catch(...)
+				{
+					errors.get(thread) = std::current_exception();
+				}
+			});
+		}
+		try
+		{
+			func(0);
+		}
+		catch(...)
+		{
+			errors.get(0) = std::current_exception();
+		}
+		for(SizeType thread = 1; thread < threads; ++thread)
+		{
+			workers[thread].join();
+		}
+		for(const std::exception_ptr &error : errors)
+		{
+			if(error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+	}
+	
+	static const ElementType *find(const BucketType &bucket, const KeyType &key)
+	{
+		for(auto it = bucket.cbegin(); it != bucket.cend(); ++it)
+		{
+			if(KeyOf::get(*it) == key)
+			{
+				return &*it;
+			}
+		}
+		return nullptr;
+	}
+	
+	void rehash(SizeType new_bucket_count)
+	{
+		Vector<BucketType> old_buckets(new_bucket_count, BucketType());
+		std::swap(old_buckets, m_buckets);
+		for(BucketType &bucket : old_buckets)
+		{
+			for(auto it = bucket.begin(); it != bucket.end(); ++it)
+			{
+				m_buckets.get(bucket_of(KeyOf::get(*it))).add_back(*it);
+			}
+		}
+	}
+	
+	template<class Pointee>
+	class HashTableIterator
+	{
+		const BucketType *m_bucket, *m_buckets_end;
+		typename BucketType::IteratorType m_link;
+		
+	public:
+		
+		HashTableIterator(const BucketType *bucket, const BucketType *buckets_end) noexcept
+			: m_bucket(bucket), m_buckets_end(buckets_end), m_link(nullptr)
+		{
+			if(m_bucket != m_buckets_end)
+			{
+				m_link = m_bucket -> cbegin();
+				skip_empty_buckets();
+			}
+		}
+		
+		Pointee &operator*() const noexcept
+		{
+			return const_cast<ElementType &>(*m_link);
+		}
+		
+		bool operator==(const HashTableIterator &other) const noexcept
+		{
+			return m_bucket == other.m_bucket && m_link == other.m_link;
+		}
+		
+		bool operator!=(const HashTableIterator &other) const noexcept
+		{
+			return !(*this == other);
+		}
+		
+		HashTableIterator &operator++() noexcept
+		{
+			++m_link;
+			skip_empty_buckets();
+			return *this;
+		}
+		
+		HashTableIterator operator++(int) noexcept
+		{
+			HashTableIterator unincremented = *this;
+			++*this;
+			return unincremented;
+		}
+		
+	private:
+		
+		void skip_empty_buckets() noexcept
+		{
+			while(m_link == m_bucket -> cend() && ++m_bucket != m_buckets_end)
+			{
+				m_link = m_bucket -> cbegin();
+			}
+		}
+	};
+};
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef Hashers_HPP
+#define Hashers_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Hash functors for the HashFunc parameter of the hash tables. Unlike std::hash, every bit of
+// the result depends on every bit of the key, so tables may take the low bits as the bucket index.
+
+namespace hashers_detail
+{
+	constexpr std::uint64_t SECRET[4] = {
+		0xA0761D6478BD642Full, 0xE7037ED1A0B428DBull, 0x8EBC6AF09C88C6E3ull, 0x589965CC75374CC3ull
+	};
+	
+	// 64x64 -> 128 bit multiply, folded back to 64 bits
+	inline std::uint64_t mum(std::uint64_t a, std::uint64_t b) noexcept
+	{
+		__uint128_t product = static_cast<__uint128_t>(a) * b;
+		return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+	}
+	
+	inline std::uint64_t read64(const unsigned char *p) noexcept
+	{
+		std::uint64_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+	
+	inline std::uint64_t read32(const unsigned char *p) noexcept
+	{
+		std::uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+}
+
+// Multiply-xorshift mixer for integers, enums and pointers.
+struct IntegerHasher
+{
+	static constexpr std::uint64_t mix(std::uint64_t x) noexcept
+	{
+		x ^= x >> 32;
+		x *= 0xD6E8FEB86659FD93ull;
+		x ^= x >> 32;
+		x *= 0xD6E8FEB86659FD93ull;
+		x ^= x >> 32;
+		return x;
+	}
+	
+	template<class T>
+	constexpr std::uint64_t operator()(T key) const noexcept
+	{
+		if constexpr(std::is_pointer_v<T>)
+		{
+			return mix(reinterpret_cast<std::uintptr_t>(key));
+		}
+		else if constexpr(std::is_enum_v<T>)
+		{
+			return mix(static_cast<std::uint64_t>(static_cast<std::underlying_type_t<T>>(key)));
+		}
+		else
+		{
+			static_assert(std::is_integral_v<T>, "IntegerHasher only hashes integers, enums and pointers");
+			return mix(static_cast<std::uint64_t>(key));
+		}
+	}
+};
+
+// wyhash-style hasher for byte strings. Keys of at least LONG_KEY_BYTES go through
+// an xxh3-style loop that keeps eight 64-bit lanes in vector registers.
+struct StringHasher
+{
+	static constexpr std::size_t LONG_KEY_BYTES = 512;
+	
+	std::uint64_t operator()(std::string_view key) const noexcept
+	{
+		return hash(reinterpret_cast<const unsigned char *>(key.data()), key.size());
+	}
+	
+	static std::uint64_t hash(const unsigned char *p, std::size_t length) noexcept
+	{
+		using namespace hashers_detail;
+		std::uint64_t seed = mum(SECRET[0], SECRET[1]);
+		std::uint64_t a, b;
+		if(length <= 16)
+		{
+			if(length >= 4)
+			{
+				std::size_t middle = (length >> 3) << 2;
+				a = (read32(p) << 32) | read32(p + middle);
+				b = (read32(p + length - 4) << 32) | read32(p + length - 4 - middle);
+			}
+			else if(length > 0)
+			{
+				a = (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[length >> 1]) << 8) | p[length - 1];
+				b = 0;
+			}
+			else
+			{
+				a = 0;
+				b = 0;
+			}
+		}
+		else if(length < LONG_KEY_BYTES)
+		{
+			std::size_t remaining = length;
+			if(remaining > 48)
+			{
+				std::uint64_t seed1 = seed, seed2 = seed;
+				do
+				{
+					seed = mum(read64(p) ^ SECRET[1], read64(p + 8) ^ seed);
+					seed1 = mum(read64(p + 16) ^ SECRET[2], read64(p + 24) ^ seed1);
+					seed2 = mum(read64(p + 32) ^ SECRET[3], read64(p + 40) ^ seed2);
+					p += 48;
+					remaining -= 48;
+				}
+				while(remaining > 48);
+				seed ^= seed1 ^ seed2;
+			}
+			while(remaining > 16)
+			{
+				seed = mum(read64(p) ^ SECRET[1], read64(p + 8) ^ seed);
+				p += 16;
+				remaining -= 16;
+			}
+			a = read64(p + remaining - 16);
+			b = read64(p + remaining - 8);
+		}
+		else
+		{
+			seed = hash_long(p, length);
+			a = read64(p + length - 16);
+			b = read64(p + length - 8);
+		}
+		__uint128_t product = static_cast<__uint128_t>(a ^ SECRET[1]) * (b ^ seed);
+		a = static_cast<std::uint64_t>(product);
+		b = static_cast<std::uint64_t>(product >> 64);
+		return mum(a ^ SECRET[0] ^ length, b ^ SECRET[1]);
+	}
+	
+private:
+	
+	typedef std::uint64_t LanesType __attribute__((vector_size(4 * sizeof(std::uint64_t))));
+	
+	static constexpr std::size_t STRIPE_BYTES = 64;
+	static constexpr std::size_t STRIPES_PER_BLOCK = 16;
+	
+	// Each 64-byte stripe is mixed into eight accumulators with 32x32 -> 64 bit multiplies,
+	// which vectorize well; the accumulators are scrambled after every 1 KiB block.
+	static std::uint64_t hash_long(const unsigned char *p, std::size_t length) noexcept
+	{
+		using namespace hashers_detail;
+		static constexpr std::uint64_t keys[STRIPES_PER_BLOCK + 8] = {
+			0xBE4BA423396CFEB8ull, 0x1CAD21F72C81017Cull, 0xDB979083E96DD4DEull, 0x1F67B3B7A4A44072ull,
+			0x78E5C0CC4EE679CBull, 0x2172FFCC7DD05A82ull, 0x8E2443F7744608B8ull, 0x4C263A81E69035E0ull,
+			0xCB00C391BB52283Cull, 0xA32E531B8B65D088ull, 0x4EF90DA297486471ull, 0xD8ACDEA946EF1938ull,
+			0x3F349CE33F76FAA8ull, 0x1D4F0BC7C7BBDCF9ull, 0x3159B4CD4BE0518Aull, 0x647378D9C97E9FC8ull,
+			0xC3EBD33483ACC5EAull, 0xEB6313FAFFA081C5ull, 0x49DAF0B751DD0D17ull, 0x9E68D429265516D3ull,
+			0xFCA1477D58BE162Bull, 0xCE31D07AD1B8F88Full, 0x280416958F3ACB45ull, 0x7E404BBBCAFBD7AFull
+		};
+		const LanesType lane_swap = { 1, 0, 3, 2 };
+		LanesType low = { SECRET[0], SECRET[1], SECRET[2], SECRET[3] };
+		LanesType high = { SECRET[3], SECRET[2], SECRET[1], SECRET[0] };
+		
+		auto accumulate = [&](const unsigned char *data, const std::uint64_t *key)
+		{
+			LanesType data_low, data_high, key_low, key_high;
+			std::memcpy(&data_low, data, sizeof(LanesType));
+			std::memcpy(&data_high, data + sizeof(LanesType), sizeof(LanesType));
+			std::memcpy(&key_low, key, sizeof(LanesType));
+			std::memcpy(&key_high, key + 4, sizeof(LanesType));
+			LanesType mixed_low = data_low ^ key_low;
+			LanesType mixed_high = data_high ^ key_high;
+			low += __builtin_shuffle(data_low, lane_swap) + (mixed_low & 0xFFFFFFFFull) * (mixed_low >> 32);
+			high += __builtin_shuffle(data_high, lane_swap) + (mixed_high & 0xFFFFFFFFull) * (mixed_high >> 32);
+		};
+		
+		std::size_t stripes = (length - 1) / STRIPE_BYTES;
+		for(std::size_t stripe = 0; stripe < stripes; ++stripe)
+		{
+			const std::uint64_t *key = keys + stripe % STRIPES_PER_BLOCK;
+			accumulate(p + stripe * STRIPE_BYTES, key);
+			if(stripe % STRIPES_PER_BLOCK == STRIPES_PER_BLOCK - 1)
+			{
+				LanesType key_low, key_high;
+				std::memcpy(&key_low, key, sizeof(LanesType));
+				std::memcpy(&key_high, key + 4, sizeof(LanesType));
+				low = ((low ^ (low >> 47)) ^ key_low) * 0x9E3779B1ull;
+				high = ((high ^ (high >> 47)) ^ key_high) * 0x9E3779B1ull;
+			}
+		}
+		// a last full stripe ending at the end of the key, overlapping the previous one, so that the
+		// bytes after the last whole stripe are mixed in too
+		accumulate(p + length - STRIPE_BYTES, keys + STRIPES_PER_BLOCK);
+		
+		std::uint64_t result = length * 0x9E3779B185EBCA87ull;
+		for(int i = 0; i < 4; i += 2)
+		{
+			result += mum(low[i] ^ keys[i], low[i + 1] ^ keys[i + 1]);
+			result += mum(high[i] ^ keys[i + 4], high[i + 1] ^ keys[i + 5]);
+		}
+		return IntegerHasher::mix(result);
+	}
+};
+
+struct Hasher;
+
+// Hashes every element of a std::pair or std::tuple with Hasher and combines the results.
+struct TupleHasher
+{
+	static std::uint64_t combine(std::uint64_t seed, std::uint64_t hash) noexcept
+	{
+		return hashers_detail::mum(seed ^ hashers_detail::SECRET[0], hash ^ hashers_detail::SECRET[1]);
+	}
+	
+	template<class First, class Second>
+	std::uint64_t operator()(const std::pair<First, Second> &key) const noexcept;
+	
+	template<class... Elems>
+	std::uint64_t operator()(const std::tuple<Elems...> &key) const noexcept;
+};
+
+// Picks IntegerHasher, StringHasher or TupleHasher depending on the key type.
+struct Hasher
+{
+	template<class T>
+	std::uint64_t operator()(const T &key) const noexcept
+	{
+		if constexpr(std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>)
+		{
+			return IntegerHasher()(key);
+		}
+		else if constexpr(std::is_convertible_v<const T &, std::string_view>)
+		{
+			return StringHasher()(key);
+		}
+		else
+		{
+			return TupleHasher()(key);
+		}
+	}
+};
+
+template<class First, class Second>
+std::uint64_t TupleHasher::operator()(const std::pair<First, Second> &key) const noexcept
+{
+	return combine(combine(0, Hasher()(key.first)), Hasher()(key.second));
+}
+
+template<class... Elems>
+std::uint64_t TupleHasher::operator()(const std::tuple<Elems...> &key) const noexcept
+{
+	std::uint64_t seed = 0;
+	std::apply([&seed](const Elems &... elems)
+	{
+		((seed = combine(seed, Hasher()(elems))), ...);
+	}, key);
+	return seed;
+}
+
+#endif
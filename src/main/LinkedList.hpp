@@ -5,6 +5,7 @@
 #include <initializer_list>
 #include <stdexcept>
 #include <new>
+#include <utility>
 
 template<class Elem>
 class LinkedList
@@ -52,11 +53,36 @@ public:
 		}
 	}
 	
+	LinkedList(const LinkedList &other)
+		: LinkedList()
+	{
+		for(ChainLink *chain_link = other.m_front; chain_link != nullptr; chain_link = chain_link -> next)
+		{
+			add_back(chain_link -> value);
+		}
+	}
+	
+	LinkedList(LinkedList &&other) noexcept
+		: m_front(other.m_front), m_back(other.m_back), m_length(other.m_length)
+	{
+		other.m_front = nullptr;
+		other.m_back = nullptr;
+		other.m_length = 0;
+	}
+	
 	~LinkedList()
 	{
 		clear();
 	}
 	
+	LinkedList &operator=(LinkedList other) noexcept
+	{
+		std::swap(m_front, other.m_front);
+		std::swap(m_back, other.m_back);
+		std::swap(m_length, other.m_length);
+		return *this;
+	}
+	
 	void add_back(const ElementType &value)
 	{
 		if(m_length == 0)
@@ -116,6 +142,14 @@ public:
 		{
 			ChainLink *old_back = m_back;
 			m_back = m_back -> prev;
+			if(m_back == nullptr)
+			{
+				m_front = nullptr;
+			}
+			else
+			{
+				m_back -> next = nullptr;
+			}
 			delete old_back;
 			--m_length;
 		}
@@ -131,11 +165,46 @@ public:
 		{
 			ChainLink *old_front = m_front;
 			m_front = m_front -> next;
+			if(m_front == nullptr)
+			{
+				m_back = nullptr;
+			}
+			else
+			{
+				m_front -> prev = nullptr;
+			}
 			delete old_front;
 			--m_length;
 		}
 	}
 	
+	// Unlinks the element at the iterator and returns an iterator to the one after it.
+	IteratorType remove(IteratorType position)
+	{
+		ChainLink *chain_link = position.m_chain_link;
+		if(chain_link == nullptr)
+		{
+			throw std::out_of_range("");
+		}
+		ChainLink *next = chain_link -> next;
+		if(chain_link == m_front)
+		{
+			remove_front();
+		}
+		else if(chain_link == m_back)
+		{
+			remove_back();
+		}
+		else
+		{
+			chain_link -> prev -> next = next;
+			next -> prev = chain_link -> prev;
+			delete chain_link;
+			--m_length;
+		}
+		return LinkedListIterator(next);
+	}
+	
 	IteratorType begin() noexcept
 	{
 		return LinkedListIterator(m_front);
@@ -146,12 +215,12 @@ public:
 		return LinkedListIterator(m_front);
 	}
 	
-	IteratorType rbegin() noexcept
+	ReverseIteratorType rbegin() noexcept
 	{
 		return LinkedListReverseIterator(m_back);
 	}
 	
-	ConstIteratorType crbegin() const noexcept
+	ConstReverseIteratorType crbegin() const noexcept
 	{
 		return LinkedListReverseIterator(m_back);
 	}
@@ -166,12 +235,12 @@ public:
 		return LinkedListIterator(nullptr);
 	}
 	
-	IteratorType rend() noexcept
+	ReverseIteratorType rend() noexcept
 	{
 		return LinkedListReverseIterator(nullptr);
 	}
 	
-	ConstIteratorType crend() const noexcept
+	ConstReverseIteratorType crend() const noexcept
 	{
 		return LinkedListReverseIterator(nullptr);
 	}
@@ -180,6 +249,8 @@ private:
 	
 	class LinkedListIterator
 	{
+		friend class LinkedList;
+		
 		ChainLink *m_chain_link;
 		
 	public:
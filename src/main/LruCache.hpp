@@ -0,0 +1,320 @@
+#ifndef LruCache_HPP
+#define LruCache_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+
+#include "Hashers.hpp"
+#include "Vector.hpp"
+
+// Fixed-capacity cache that evicts the least recently used element. All nodes are allocated up
+// front in one pool: each node is linked into a LinkedList-style doubly linked recency list and into
+// the chain of its HashMap-style bucket, both by index. Once constructed, get, put and remove never
+// allocate and take O(1) expected time.
+template<class Key, class Value, class HashFunc>
+class LruCache
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef Value ValueType;
+	typedef HashFunc HasherType;
+	
+	struct Statistics
+	{
+		std::uint64_t hits, misses, evictions;
+	};
+	
+private:
+	
+	static constexpr SizeType NONE = ~SizeType(0);
+	
+	// prev and next link the recency list (or the free list, through next); chain links the bucket
+	struct Node
+	{
+		KeyType key;
+		ValueType value;
+		SizeType prev, next, chain;
+	};
+	
+	Vector<Node> m_nodes;
+	Vector<SizeType> m_buckets;
+	SizeType m_front, m_back, m_free, m_length;
+	HasherType m_hasher;
+	Statistics m_statistics;
+	
+public:
+	
+	LruCache(SizeType capacity, const HasherType &hash_function = HasherType())
+		: m_nodes(capacity, Node()),
+		m_buckets(capacity, NONE),
+		m_front(NONE),
+		m_back(NONE),
+		m_free(0),
+		m_length(0),
+		m_hasher(hash_function),
+		m_statistics()
+	{
+		if(capacity == 0)
+		{
+			throw std::invalid_argument("");
+		}
+		for(SizeType i = 0; i < capacity; ++i)
+		{
+			m_nodes.get(i).next = i + 1 < capacity ? i + 1 : NONE;
+		}
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	SizeType capacity() const noexcept
+	{
+		return m_nodes.count();
+	}
+	
+	// Does not count as a use of the element.
+	bool contains(const KeyType &key) const
+	{
+		return find(key) != NONE;
+	}
+	
+	// A miss is an ordinary outcome for a cache, so it gives nullptr instead of throwing.
+	// A hit makes the element the most recently used one.
+	ValueType *get(const KeyType &key)
+	{
+		SizeType node = find(key);
+		if(node == NONE)
+		{
+			++m_statistics.misses;
+			return nullptr;
+		}
+		++m_statistics.hits;
+		move_to_front(node);
+		return &m_nodes.get(node).value;
+	}
+	
+	// Inserts or overwrites the element and makes it the most recently used one,
+	// evicting the least recently used element when the cache is full.
+	void put(const KeyType &key, const ValueType &value)
+	{
+		SizeType node = find(key);
+		if(node != NONE)
+		{
+			m_nodes.get(node).value = value;
+			move_to_front(node);
+			return;
+		}
+		if(m_free == NONE)
+		{
+			++m_statistics.evictions;
+			release(m_back);
+		}
+		node = m_free;
+		Node &slot = m_nodes.get(node);
+		m_free = slot.next;
+		slot.key = key;
+		slot.value = value;
+		SizeType bucket = bucket_of(key);
+		slot.chain = m_buckets.get(bucket);
+		m_buckets.set(bucket, node);
+		link_front(node);
+		++m_length;
+	}
+	
+	void remove(const KeyType &key)
+	{
+		SizeType node = find(key);
+		if(node == NONE)
+		{
+			throw std::out_of_range("");
+		}
+		release(node);
+	}
+	
+	void clear()
+	{
+		while(m_back != NONE)
+		{
+			release(m_back);
+		}
+	}
+	
+	const Statistics &statistics() const noexcept
+	{
+		return m_statistics;
+	}
+	
+	void reset_statistics() noexcept
+	{
+		m_statistics = Statistics();
+	}
+	
+private:
+	
+	SizeType bucket_of(const KeyType &key) const
+	{
+		return static_cast<SizeType>(m_hasher(key)) % m_buckets.count();
+	}
+	
+	SizeType find(const KeyType &key) const
+	{
+		SizeType node = m_buckets.get(bucket_of(key));
+		while(node != NONE && !(m_nodes.get(node).key == key))
+		{
+			node = m_nodes.get(node).chain;
+		}
+		return node;
+	}
+	
+	void unlink(SizeType node)
+	{
+		Node &links = m_nodes.get(node);
+		(links.prev == NONE ? m_front : m_nodes.get(links.prev).next) = links.next;
+		(links.next == NONE ? m_back : m_nodes.get(links.next).prev) = links.prev;
+	}
+	
+	void link_front(SizeType node)
+	{
+		Node &links = m_nodes.get(node);
+		links.prev = NONE;
+		links.next = m_front;
+		(m_front == NONE ? m_back : m_nodes.get(m_front).prev) = node;
+		m_front = node;
+	}
+	
+	void move_to_front(SizeType node)
+	{
+		if(node != m_front)
+		{
+			unlink(node);
+			link_front(node);
+		}
+	}
+	
+	// Takes the node out of its bucket chain and the recency list and puts it on the free list.
+	// The key and value are reset, so that whatever they hold is let go now and not on reuse.
+	void release(SizeType node)
+	{
+		SizeType bucket = bucket_of(m_nodes.get(node).key);
+		SizeType *link = &m_buckets.get(bucket);
+		while(*link != node)
+		{
+			link = &m_nodes.get(*link).chain;
+		}
+		*link = m_nodes.get(node).chain;
+		unlink(node);
+		m_nodes.get(node).key = KeyType();
+		m_nodes.get(node).value = ValueType();
+		m_nodes.get(node).next = m_free;
+		m_free = node;
+		--m_length;
+	}
+};
+
+// LruCache split into Shards independent caches, each behind its own mutex, so that threads
+// using different keys rarely wait for each other. Recency is tracked per shard. Values are
+// copied out, since a pointer into a shard would outlive the lock.
+template<class Key, class Value, class HashFunc, std::size_t Shards = 16>
+class ShardedLruCache
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef Value ValueType;
+	typedef HashFunc HasherType;
+	typedef typename LruCache<Key, Value, HashFunc>::Statistics Statistics;
+	
+private:
+	
+	// each shard gets its own cache lines, so locking one does not slow down its neighbours
+	struct alignas(64) Shard
+	{
+		std::mutex mutex;
+		LruCache<Key, Value, HashFunc> cache{1};
+	};
+	
+	Shard m_shards[Shards];
+	HasherType m_hasher;
+	
+public:
+	
+	// The capacity is split evenly between the shards, rounding up.
+	ShardedLruCache(SizeType capacity, const HasherType &hash_function = HasherType())
+		: m_hasher(hash_function)
+	{
+		for(Shard &shard : m_shards)
+		{
+			shard.cache = LruCache<Key, Value, HashFunc>((capacity + Shards - 1) / Shards, hash_function);
+		}
+	}
+	
+	// Copies the value out on a hit.
+	bool get(const KeyType &key, ValueType &value)
+	{
+		Shard &shard = shard_of(key);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		ValueType *found = shard.cache.get(key);
+		if(found == nullptr)
+		{
+			return false;
+		}
+		value = *found;
+		return true;
+	}
+	
+	void put(const KeyType &key, const ValueType &value)
+	{
+		Shard &shard = shard_of(key);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.cache.put(key, value);
+	}
+	
+	void remove(const KeyType &key)
+	{
+		Shard &shard = shard_of(key);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.cache.remove(key);
+	}
+	
+	SizeType count()
+	{
+		SizeType length = 0;
+		for(Shard &shard : m_shards)
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			length += shard.cache.count();
+		}
+		return length;
+	}
+	
+	// The sum over all shards.
+	Statistics statistics()
+	{
+		Statistics total = Statistics();
+		for(Shard &shard : m_shards)
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			total.hits += shard.cache.statistics().hits;
+			total.misses += shard.cache.statistics().misses;
+			total.evictions += shard.cache.statistics().evictions;
+		}
+		return total;
+	}
+	
+private:
+	
+	// Mixed again so that the shard does not follow the bucket the key lands in within its shard.
+	Shard &shard_of(const KeyType &key)
+	{
+		return m_shards[IntegerHasher::mix(static_cast<std::uint64_t>(m_hasher(key))) % Shards];
+	}
+};
+
+#endif
@@ -0,0 +1,562 @@
+#ifndef PersistentVector_HPP
+#define PersistentVector_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+// Immutable vector stored as a 32-way trie plus a tail leaf. Copying one is O(1), and every
+// "modification" returns a new version that shares all but the O(log32 n) nodes on the changed path.
+// For batches of changes, get a TransientType, which edits the nodes it has already copied in place.
+template<class Elem>
+class PersistentVector
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Elem ElementType;
+	
+	static constexpr SizeType BRANCH_BITS = 5;
+	static constexpr SizeType BRANCH_FACTOR = SizeType(1) << BRANCH_BITS;
+	
+private:
+	
+	static constexpr SizeType BRANCH_MASK = BRANCH_FACTOR - 1;
+	
+	// owner is the id of the transient allowed to edit the node in place, 0 for none
+	struct Node
+	{
+		std::atomic<SizeType> references;
+		std::uint64_t owner;
+		bool leaf;
+	};
+	
+	struct InnerNode : Node
+	{
+		Node *children[BRANCH_FACTOR];
+	};
+	
+	struct LeafNode : Node
+	{
+		ElementType values[BRANCH_FACTOR];
+	};
+	
+	class PersistentVectorIterator;
+	class PersistentVectorTransient;
+	
+public:
+	
+	typedef PersistentVectorIterator ConstIteratorType;
+	typedef PersistentVectorTransient TransientType;
+	
+private:
+	
+	SizeType m_length, m_shift;
+	InnerNode *m_root;
+	LeafNode *m_tail;
+	
+public:
+	
+	PersistentVector() noexcept
+		: m_length(0), m_shift(BRANCH_BITS), m_root(nullptr), m_tail(nullptr)
+	{}
+	
+	PersistentVector(std::initializer_list<ElementType> elements)
+		: PersistentVector()
+	{
+		for(const ElementType &value : elements)
+		{
+			push(value, 0);
+		}
+	}
+	
+	PersistentVector(const PersistentVector &other) noexcept
+		: m_length(other.m_length), m_shift(other.m_shift), m_root(other.m_root), m_tail(other.m_tail)
+	{
+		retain(m_root);
+		retain(m_tail);
+	}
+	
+	PersistentVector(PersistentVector &&other) noexcept
+		: m_length(other.m_length), m_shift(other.m_shift), m_root(other.m_root), m_tail(other.m_tail)
+	{
+		other.m_length = 0;
+		other.m_shift = BRANCH_BITS;
+		other.m_root = nullptr;
+		other.m_tail = nullptr;
+	}
+	
+	~PersistentVector()
+	{
+		release(m_root);
+		release(m_tail);
+	}
+	
+	PersistentVector &operator=(PersistentVector other) noexcept
+	{
+		std::swap(m_length, other.m_length);
+		std::swap(m_shift, other.m_shift);
+		std::swap(m_root, other.m_root);
+		std::swap(m_tail, other.m_tail);
+		return *this;
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	const ElementType &get(SizeType pos) const
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		return leaf_for(pos) -> values[pos & BRANCH_MASK];
+	}
+	
+	const ElementType &get_back() const
+	{
+		if(m_length == 0)
+		{
+			throw std::out_of_range("");
+		}
+		return get(m_length - 1);
+	}
+	
+	[[nodiscard]] PersistentVector add_back(const ElementType &value) const
+	{
+		PersistentVector result(*this);
+		result.push(value, 0);
+		return result;
+	}
+	
+	[[nodiscard]] PersistentVector set(SizeType pos, const ElementType &value) const
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		PersistentVector result(*this);
+		result.assign(pos, value, 0);
+		return result;
+	}
+	
+	[[nodiscard]] PersistentVector remove_back() const
+	{
+		if(m_length == 0)
+		{
+			throw std::out_of_range("");
+		}
+		PersistentVector result(*this);
+		result.pop(0);
+		return result;
+	}
+	
+	TransientType transient() const
+	{
+		return PersistentVectorTransient(*this);
+	}
+	
+	ConstIteratorType cbegin() const noexcept
+	{
+		return PersistentVectorIterator(this, 0);
+	}
+	
+	ConstIteratorType cend() const noexcept
+	{
+		return PersistentVectorIterator(this, m_length);
+	}
+	
+	ConstIteratorType begin() const noexcept
+	{
+		return cbegin();
+	}
+	
+	ConstIteratorType end() const noexcept
+	{
+		return cend();
+	}
+	
+private:
+	
+	static std::uint64_t next_owner() noexcept
+	{
+		static std::atomic<std::uint64_t> last_owner(0);
+		return ++last_owner;
+	}
+	
+	static void retain(Node *node) noexcept
+	{
+		if(node != nullptr)
+		{
+			node -> references.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	
+	static void release(Node *node) noexcept
+	{
+		if(node == nullptr || node -> references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		{
+			return;
+		}
+		if(node -> leaf)
+		{
+			delete static_cast<LeafNode *>(node);
+		}
+		else
+		{
+			InnerNode *inner = static_cast<InnerNode *>(node);
+			for(Node *child : inner -> children)
+			{
+				release(child);
+			}
+			delete inner;
+		}
+	}
+	
+	static InnerNode *new_inner(std::uint64_t owner)
+	{
+		InnerNode *inner = new InnerNode();
+		inner -> references.store(1, std::memory_order_relaxed);
+		inner -> owner = owner;
+		inner -> leaf = false;
+		for(Node *&child : inner -> children)
+		{
+			child = nullptr;
+		}
+		return inner;
+	}
+	
+	static LeafNode *new_leaf(std::uint64_t owner)
+	{
+		LeafNode *leaf = new LeafNode();
+		leaf -> references.store(1, std::memory_order_relaxed);
+		leaf -> owner = owner;
+		leaf -> leaf = true;
+		return leaf;
+	}
+	
+	// The node itself if the given owner may edit it in place, otherwise a copy that it may edit.
+	// Either way the caller's reference to the original is consumed.
+	static InnerNode *editable_inner(InnerNode *node, std::uint64_t owner)
+	{
+		if(node != nullptr && owner != 0 && node -> owner == owner)
+		{
+			return node;
+		}
+		InnerNode *copy = new_inner(owner);
+		if(node != nullptr)
+		{
+			for(SizeType i = 0; i < BRANCH_FACTOR; ++i)
+			{
+				copy -> children[i] = node -> children[i];
+				retain(copy -> children[i]);
+			}
+			release(node);
+		}
+		return copy;
+	}
+	
+	static LeafNode *editable_leaf(LeafNode *node, SizeType length, std::uint64_t owner)
+	{
+		if(node != nullptr && owner != 0 && node -> owner == owner)
+		{
+			return node;
+		}
+		LeafNode *copy = new_leaf(owner);
+		if(node != nullptr)
+		{
+			for(SizeType i = 0; i < length; ++i)
+			{
+				copy -> values[i] = node -> values[i];
+			}
+			release(node);
+		}
+		return copy;
+	}
+	
+	SizeType tail_offset() const noexcept
+	{
+		return m_length < BRANCH_FACTOR ? 0 : ((m_length - 1) >> BRANCH_BITS) << BRANCH_BITS;
+	}
+	
+	LeafNode *leaf_for(SizeType pos) const noexcept
+	{
+		if(pos >= tail_offset())
+		{
+			return m_tail;
+		}
+		Node *node = m_root;
+		for(SizeType level = m_shift; level > 0; level -= BRANCH_BITS)
+		{
+			node = static_cast<InnerNode *>(node) -> children[(pos >> level) & BRANCH_MASK];
+		}
+		return static_cast<LeafNode *>(node);
+	}
+	
+	// A chain of single-child inner nodes from the given level down to the leaf.
+	static Node *new_path(SizeType level, LeafNode *leaf, std::uint64_t owner)
+	{
+		if(level == 0)
+		{
+			return leaf;
+		}
+		InnerNode *inner = new_inner(owner);
+		inner -> children[0] = new_path(level - BRANCH_BITS, leaf, owner);
+		return inner;
+	}
+	
+	void push(const ElementType &value, std::uint64_t owner)
+	{
+		SizeType tail_length = m_length - tail_offset();
+		if(tail_length < BRANCH_FACTOR)
+		{
+			m_tail = editable_leaf(m_tail, tail_length, owner);
+			m_tail -> values[tail_length] = value;
+			++m_length;
+			return;
+		}
+		if((m_length >> BRANCH_BITS) > (SizeType(1) << m_shift))
+		{
+			InnerNode *root = new_inner(owner);
+			root -> children[0] = m_root;
+			root -> children[1] = new_path(m_shift, m_tail, owner);
+			m_root = root;
+			m_shift += BRANCH_BITS;
+		}
+		else
+		{
+			m_root = editable_inner(m_root, owner);
+			push_tail(m_shift, m_root, m_tail, owner);
+		}
+		m_tail = new_leaf(owner);
+		m_tail -> values[0] = value;
+		++m_length;
+	}
+	
+	void push_tail(SizeType level, InnerNode *parent, LeafNode *tail, std::uint64_t owner)
+	{
+		SizeType index = ((m_length - 1) >> level) & BRANCH_MASK;
+		if(level == BRANCH_BITS)
+		{
+			parent -> children[index] = tail;
+			return;
+		}
+		InnerNode *child = static_cast<InnerNode *>(parent -> children[index]);
+		if(child == nullptr)
+		{
+			parent -> children[index] = new_path(level - BRANCH_BITS, tail, owner);
+			return;
+		}
+		child = editable_inner(child, owner);
+		parent -> children[index] = child;
+		push_tail(level - BRANCH_BITS, child, tail, owner);
+	}
+	
+	void assign(SizeType pos, const ElementType &value, std::uint64_t owner)
+	{
+		if(pos >= tail_offset())
+		{
+			m_tail = editable_leaf(m_tail, m_length - tail_offset(), owner);
+			m_tail -> values[pos & BRANCH_MASK] = value;
+			return;
+		}
+		m_root = editable_inner(m_root, owner);
+		InnerNode *node = m_root;
+		for(SizeType level = m_shift; level > BRANCH_BITS; level -= BRANCH_BITS)
+		{
+			SizeType index = (pos >> level) & BRANCH_MASK;
+			InnerNode *child = editable_inner(static_cast<InnerNode *>(node -> children[index]), owner);
+			node -> children[index] = child;
+			node = child;
+		}
+		SizeType index = (pos >> BRANCH_BITS) & BRANCH_MASK;
+		LeafNode *leaf = editable_leaf(static_cast<LeafNode *>(node -> children[index]), BRANCH_FACTOR, owner);
+		node -> children[index] = leaf;
+		leaf -> values[pos & BRANCH_MASK] = value;
+	}
+	
+	void pop(std::uint64_t owner)
+	{
+		if(m_length == 0)
+		{
+			throw std::out_of_range("");
+		}
+		if(m_length - tail_offset() > 1)
+		{
+			--m_length;
+			return;
+		}
+		if(m_length == 1)
+		{
+			release(m_tail);
+			m_tail = nullptr;
+			m_length = 0;
+			return;
+		}
+		// the tail is about to be empty, so the last leaf of the trie becomes the tail
+		LeafNode *new_tail = leaf_for(m_length - 2);
+		retain(new_tail);
+		m_root = pop_tail(m_shift, m_root, owner);
+		if(m_root == nullptr)
+		{
+			m_shift = BRANCH_BITS;
+		}
+		else if(m_shift > BRANCH_BITS && m_root -> children[1] == nullptr)
+		{
+			InnerNode *child = static_cast<InnerNode *>(m_root -> children[0]);
+			retain(child);
+			release(m_root);
+			m_root = child;
+			m_shift -= BRANCH_BITS;
+		}
+		release(m_tail);
+		m_tail = new_tail;
+		--m_length;
+	}
+	
+	// Drops the last leaf below node, consuming the caller's reference to node.
+	// Returns the new version of node, or nullptr if nothing is left under it.
+	InnerNode *pop_tail(SizeType level, InnerNode *node, std::uint64_t owner)
+	{
+		SizeType index = ((m_length - 2) >> level) & BRANCH_MASK;
+		if(level > BRANCH_BITS)
+		{
+			node = editable_inner(node, owner);
+			InnerNode *child = pop_tail(level - BRANCH_BITS, static_cast<InnerNode *>(node -> children[index]), owner);
+			node -> children[index] = child;
+			if(child == nullptr && index == 0)
+			{
+				release(node);
+				return nullptr;
+			}
+			return node;
+		}
+		if(index == 0)
+		{
+			release(node);
+			return nullptr;
+		}
+		node = editable_inner(node, owner);
+		release(node -> children[index]);
+		node -> children[index] = nullptr;
+		return node;
+	}
+	
+	class PersistentVectorIterator
+	{
+		const PersistentVector *m_vector;
+		SizeType m_pos;
+		const LeafNode *m_leaf;
+		
+	public:
+		
+		PersistentVectorIterator(const PersistentVector *vector, SizeType pos)
+			: m_vector(vector), m_pos(pos), m_leaf(pos < vector -> m_length ? vector -> leaf_for(pos) : nullptr)
+		{}
+		
+		const ElementType &operator*() const
+		{
+			if(m_leaf == nullptr)
+			{
+				throw std::out_of_range("");
+			}
+			return m_leaf -> values[m_pos & BRANCH_MASK];
+		}
+		
+		bool operator==(const PersistentVectorIterator &other) const noexcept
+		{
+			return m_pos == other.m_pos;
+		}
+		
+		bool operator!=(const PersistentVectorIterator &other) const noexcept
+		{
+			return m_pos != other.m_pos;
+		}
+		
+		PersistentVectorIterator operator++(int) noexcept
+		{
+			PersistentVectorIterator unincremented(*this);
+			++(*this);
+			return unincremented;
+		}
+		
+		// only looks the leaf up again when crossing into the next one
+		PersistentVectorIterator &operator++() noexcept
+		{
+			++m_pos;
+			if((m_pos & BRANCH_MASK) == 0)
+			{
+				m_leaf = m_pos < m_vector -> m_length ? m_vector -> leaf_for(m_pos) : nullptr;
+			}
+			return *this;
+		}
+	};
+	
+	// Mutable view of a vector for batch building. It starts out sharing every node with the vector
+	// it came from, copies a node the first time it edits it, and from then on edits that copy in place.
+	class PersistentVectorTransient
+	{
+		PersistentVector m_vector;
+		std::uint64_t m_owner;
+		
+	public:
+		
+		PersistentVectorTransient(const PersistentVector &vector)
+			: m_vector(vector), m_owner(next_owner())
+		{}
+		
+		PersistentVectorTransient(const PersistentVectorTransient &other) = delete;
+		
+		PersistentVectorTransient(PersistentVectorTransient &&other) noexcept
+			: m_vector(std::move(other.m_vector)), m_owner(other.m_owner)
+		{
+			other.m_owner = next_owner();
+		}
+		
+		PersistentVectorTransient &operator=(const PersistentVectorTransient &other) = delete;
+		
+		SizeType count() const noexcept
+		{
+			return m_vector.count();
+		}
+		
+		const ElementType &get(SizeType pos) const
+		{
+			return m_vector.get(pos);
+		}
+		
+		void add_back(const ElementType &value)
+		{
+			m_vector.push(value, m_owner);
+		}
+		
+		void set(SizeType pos, const ElementType &value)
+		{
+			if(pos >= m_vector.count())
+			{
+				throw std::out_of_range("");
+			}
+			m_vector.assign(pos, value, m_owner);
+		}
+		
+		void remove_back()
+		{
+			m_vector.pop(m_owner);
+		}
+		
+		// A snapshot of the current contents. The transient stays usable, but stops editing
+		// the nodes it shares with the snapshot in place.
+		PersistentVector persistent()
+		{
+			m_owner = next_owner();
+			return m_vector;
+		}
+	};
+};
+
+#endif
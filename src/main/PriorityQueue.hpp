@@ -0,0 +1,382 @@
+#ifndef PriorityQueue_HPP
+#define PriorityQueue_HPP
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "Vector.hpp"
+
+// Heap with four children per node: half as deep as a binary heap, and the four children of a node
+// usually share a cache line. The top is the element that Compare orders first, so the default
+// std::less gives the smallest element.
+template<class Elem, class Compare = std::less<Elem>>
+class PriorityQueue
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Elem ElementType;
+	typedef Compare CompareType;
+	
+	static constexpr SizeType ARITY = 4;
+	
+private:
+	
+	Vector<ElementType> m_heap;
+	CompareType m_compare;
+	
+public:
+	
+	PriorityQueue(const CompareType &compare = CompareType())
+		: m_heap(0), m_compare(compare)
+	{}
+	
+	// Builds the heap bottom-up in O(n).
+	PriorityQueue(const Vector<ElementType> &elements, const CompareType &compare = CompareType())
+		: m_heap(elements), m_compare(compare)
+	{
+		heapify();
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_heap.count();
+	}
+	
+	const ElementType &get_top() const
+	{
+		return m_heap.get_front();
+	}
+	
+	void add(const ElementType &value)
+	{
+		m_heap.add_back(value);
+		sift_up(m_heap.count() - 1);
+	}
+	
+	// Adds all the elements at once. When the batch is large compared to the heap,
+	// rebuilding the whole heap in O(n + k) beats sifting each element up.
+	void add_many(const Vector<ElementType> &elements)
+	{
+		SizeType old_length = m_heap.count();
+		Vector<ElementType> grown(old_length + elements.count(), ElementType());
+		for(SizeType i = 0; i < old_length; ++i)
+		{
+			grown.set(i, std::move(m_heap.get(i)));
+		}
+		for(SizeType i = 0; i < elements.count(); ++i)
+		{
+			grown.set(old_length + i, elements.get(i));
+		}
+		m_heap = std::move(grown);
+		if(elements.count() * 8 > old_length)
+		{
+			heapify();
+		}
+		else
+		{
+			for(SizeType i = old_length; i < m_heap.count(); ++i)
+			{
+				sift_up(i);
+			}
+		}
+	}
+	
+	void remove_top()
+	{
+		if(m_heap.count() == 0)
+		{
+			throw std::out_of_range("");
+		}
+		if(m_heap.count() > 1)
+		{
+			ElementType last = std::move(m_heap.get_back());
+			m_heap.remove_back();
+			// the last element almost always belongs near the bottom, so walk the hole all the way
+			// down without comparing against it, then sift it up the few levels it needs
+			SizeType hole = hole_to_leaf(0);
+			m_heap.get(hole) = std::move(last);
+			sift_up(hole);
+		}
+		else
+		{
+			m_heap.remove_back();
+		}
+	}
+	
+	void clear()
+	{
+		m_heap.clear();
+	}
+	
+private:
+	
+	void heapify()
+	{
+		if(m_heap.count() < 2)
+		{
+			return;
+		}
+		for(SizeType i = (m_heap.count() - 2) / ARITY + 1; i > 0; --i)
+		{
+			ElementType value = std::move(m_heap.get(i - 1));
+			sift_down(i - 1, std::move(value));
+		}
+	}
+	
+	// Both sifts move a hole instead of swapping, so each level costs one move.
+	void sift_up(SizeType pos)
+	{
+		ElementType value = std::move(m_heap.get(pos));
+		while(pos > 0)
+		{
+			SizeType parent = (pos - 1) / ARITY;
+			if(!m_compare(value, m_heap.get(parent)))
+			{
+				break;
+			}
+			m_heap.get(pos) = std::move(m_heap.get(parent));
+			pos = parent;
+		}
+		m_heap.get(pos) = std::move(value);
+	}
+	
+	// Moves the smallest child up into the hole at each level until the hole reaches a leaf.
+	SizeType hole_to_leaf(SizeType pos)
+	{
+		ElementType *heap = m_heap.begin();
+		SizeType length = m_heap.count();
+		for(;;)
+		{
+			SizeType first_child = pos * ARITY + 1;
+			if(first_child >= length)
+			{
+				return pos;
+			}
+			SizeType last_child = first_child + ARITY < length ? first_child + ARITY : length;
+			SizeType best = first_child;
+			for(SizeType child = first_child + 1; child < last_child; ++child)
+			{
+				best = m_compare(heap[child], heap[best]) ? child : best;
+			}
+			heap[pos] = std::move(heap[best]);
+			pos = best;
+		}
+	}
+	
+	// Indexes the buffer directly: this is the hot loop of remove_top and heapify.
+	void sift_down(SizeType pos, ElementType value)
+	{
+		ElementType *heap = m_heap.begin();
+		SizeType length = m_heap.count();
+		for(;;)
+		{
+			SizeType first_child = pos * ARITY + 1;
+			if(first_child >= length)
+			{
+				break;
+			}
+			SizeType last_child = first_child + ARITY < length ? first_child + ARITY : length;
+			SizeType best = first_child;
+			for(SizeType child = first_child + 1; child < last_child; ++child)
+			{
+				best = m_compare(heap[child], heap[best]) ? child : best;
+			}
+			if(!m_compare(heap[best], value))
+			{
+				break;
+			}
+			heap[pos] = std::move(heap[best]);
+			pos = best;
+		}
+		heap[pos] = std::move(value);
+	}
+};
+
+// 4-ary heap of ids 0 .. id_count - 1, each with a priority that can be changed while it is queued
+// (decrease-key, as in Dijkstra's algorithm). A position table makes finding an id in the heap O(1).
+template<class Priority, class Compare = std::less<Priority>>
+class IndexedPriorityQueue
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Priority PriorityType;
+	typedef Compare CompareType;
+	
+	static constexpr SizeType ARITY = 4;
+	
+private:
+	
+	static constexpr SizeType NONE = ~SizeType(0);
+	
+	Vector<SizeType> m_heap;
+	Vector<SizeType> m_positions;
+	Vector<PriorityType> m_priorities;
+	CompareType m_compare;
+	
+public:
+	
+	IndexedPriorityQueue(SizeType id_count, const CompareType &compare = CompareType())
+		: m_heap(0), m_positions(id_count, NONE), m_priorities(id_count, PriorityType()), m_compare(compare)
+	{}
+	
+	SizeType count() const noexcept
+	{
+		return m_heap.count();
+	}
+	
+	bool contains(SizeType id) const
+	{
+		return m_positions.get(id) != NONE;
+	}
+	
+	SizeType get_top() const
+	{
+		return m_heap.get_front();
+	}
+	
+	const PriorityType &get_top_priority() const
+	{
+		return m_priorities.get(m_heap.get_front());
+	}
+	
+	const PriorityType &get_priority(SizeType id) const
+	{
+		if(!contains(id))
+		{
+			throw std::out_of_range("");
+		}
+		return m_priorities.get(id);
+	}
+	
+	// Throws when the id is already queued.
+	void add(SizeType id, const PriorityType &priority)
+	{
+		if(contains(id))
+		{
+			throw std::invalid_argument("");
+		}
+		m_priorities.set(id, priority);
+		m_heap.add_back(id);
+		m_positions.set(id, m_heap.count() - 1);
+		sift_up(m_heap.count() - 1);
+	}
+	
+	// Moves the id up or down the heap as its new priority requires.
+	void change_priority(SizeType id, const PriorityType &priority)
+	{
+		if(!contains(id))
+		{
+			throw std::out_of_range("");
+		}
+		bool earlier = m_compare(priority, m_priorities.get(id));
+		m_priorities.set(id, priority);
+		if(earlier)
+		{
+			sift_up(m_positions.get(id));
+		}
+		else
+		{
+			sift_down(m_positions.get(id));
+		}
+	}
+	
+	// Adds the id, or changes its priority when it is already queued.
+	void set(SizeType id, const PriorityType &priority)
+	{
+		if(contains(id))
+		{
+			change_priority(id, priority);
+		}
+		else
+		{
+			add(id, priority);
+		}
+	}
+	
+	void remove_top()
+	{
+		if(m_heap.count() == 0)
+		{
+			throw std::out_of_range("");
+		}
+		remove(m_heap.get_front());
+	}
+	
+	void remove(SizeType id)
+	{
+		if(!contains(id))
+		{
+			throw std::out_of_range("");
+		}
+		SizeType pos = m_positions.get(id);
+		SizeType last = m_heap.get_back();
+		m_heap.remove_back();
+		m_positions.set(id, NONE);
+		if(last != id)
+		{
+			place(pos, last);
+			sift_up(pos);
+			sift_down(m_positions.get(last));
+		}
+	}
+	
+private:
+	
+	void place(SizeType pos, SizeType id)
+	{
+		m_heap.set(pos, id);
+		m_positions.set(id, pos);
+	}
+	
+	void sift_up(SizeType pos)
+	{
+		SizeType id = m_heap.get(pos);
+		while(pos > 0)
+		{
+			SizeType parent = (pos - 1) / ARITY;
+			if(!m_compare(m_priorities.get(id), m_priorities.get(m_heap.get(parent))))
+			{
+				break;
+			}
+			place(pos, m_heap.get(parent));
+			pos = parent;
+		}
+		place(pos, id);
+	}
+	
+	void sift_down(SizeType pos)
+	{
+		SizeType id = m_heap.get(pos);
+		SizeType length = m_heap.count();
+		for(;;)
+		{
+			SizeType first_child = pos * ARITY + 1;
+			if(first_child >= length)
+			{
+				break;
+			}
+			SizeType last_child = first_child + ARITY < length ? first_child + ARITY : length;
+			SizeType best = first_child;
+			for(SizeType child = first_child + 1; child < last_child; ++child)
+			{
+				if(m_compare(m_priorities.get(m_heap.get(child)), m_priorities.get(m_heap.get(best))))
+				{
+					best = child;
+				}
+			}
+			if(!m_compare(m_priorities.get(m_heap.get(best)), m_priorities.get(id)))
+			{
+				break;
+			}
+			place(pos, m_heap.get(best));
+			pos = best;
+		}
+		place(pos, id);
+	}
+};
+
+#endif
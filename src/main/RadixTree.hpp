@@ -0,0 +1,1009 @@
+#ifndef RadixTree_HPP
+#define RadixTree_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Ordered map stored as an adaptive radix tree (Leis et al., "The Adaptive Radix Tree"). A key is
+// taken as a string of bytes, one byte per level: std::string keys byte by byte, integer keys
+// big-endian with the sign bit flipped, so that byte order is key order. Inner nodes come in four
+// sizes (4, 16, 48 and 256 children) and grow and shrink with their child count; a chain of
+// single-child nodes is compressed into a prefix kept in the node below it. Only the first
+// MAX_PREFIX bytes of a prefix are stored; lookups skip the rest and compare the whole key at the
+// leaf instead. A key that is a prefix of other keys sits in the terminal slot of the node where
+// it ends.
+template<class Key, class Value>
+class RadixTree
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Key KeyType;
+	typedef Value ValueType;
+	
+	static constexpr SizeType MAX_PREFIX = 8;
+	
+private:
+	
+	enum class NodeType : std::uint8_t
+	{
+		LEAF, NODE4, NODE16, NODE48, NODE256
+	};
+	
+	struct Node
+	{
+		NodeType type;
+	};
+	
+	struct Leaf : Node
+	{
+		KeyType key;
+		ValueType value;
+	};
+	
+	struct Inner : Node
+	{
+		std::uint16_t count;
+		std::uint32_t prefix_length;
+		unsigned char prefix[MAX_PREFIX];
+		Leaf *terminal;
+	};
+	
+	// keys are kept sorted in Node4 and Node16, so that children are visited in order
+	struct Node4 : Inner
+	{
+		unsigned char keys[4];
+		Node *children[4];
+	};
+	
+	struct Node16 : Inner
+	{
+		alignas(16) unsigned char keys[16];
+		Node *children[16];
+	};
+	
+	// index[byte] is the child's slot + 1, or 0 when there is no child for the byte
+	struct Node48 : Inner
+	{
+		unsigned char index[256];
+		Node *children[48];
+	};
+	
+	struct Node256 : Inner
+	{
+		Node *children[256];
+	};
+	
+	typedef unsigned char BytesType __attribute__((vector_size(16)));
+	
+	// The bytes of a key. Integer keys are encoded into the object itself, so it is not copied around.
+	class KeyBytes
+	{
+		unsigned char m_encoded[sizeof(KeyType) < 8 ? 8 : sizeof(KeyType)];
+		const unsigned char *m_data;
+		SizeType m_length;
+		
+	public:
+		
+		KeyBytes(const KeyType &key) noexcept
+		{
+			if constexpr(std::is_integral_v<KeyType>)
+			{
+				typedef std::make_unsigned_t<KeyType> UnsignedType;
+				UnsignedType bits = static_cast<UnsignedType>(key);
+				if constexpr(std::is_signed_v<KeyType>)
+				{
+					bits ^= UnsignedType(1) << (sizeof(KeyType) * 8 - 1);
+				}
+				for(SizeType i = sizeof(KeyType); i > 0; --i)
+				{
+					m_encoded[i - 1] = static_cast<unsigned char>(bits);
+					bits = static_cast<UnsignedType>(bits >> 7 >> 1);
+				}
+				m_data = m_encoded;
+				m_length = sizeof(KeyType);
+			}
+			else
+			{
+				m_data = reinterpret_cast<const unsigned char *>(key.data());
+				m_length = key.size();
+			}
+		}
+		
+		KeyBytes(const KeyBytes &) = delete;
+		
+		const unsigned char *data() const noexcept
+		{
+			return m_data;
+		}
+		
+		SizeType length() const noexcept
+		{
+			return m_length;
+		}
+		
+		unsigned char operator[](SizeType pos) const noexcept
+		{
+			return m_data[pos];
+		}
+	};
+	
+	Node *m_root;
+	SizeType m_length;
+	SizeType m_node_counts[5];
+	
+public:
+	
+	RadixTree()
+		: m_root(nullptr), m_length(0), m_node_counts()
+	{}
+	
+	RadixTree(const RadixTree &other) = delete;
+	
+	RadixTree(RadixTree &&other) noexcept
+		: RadixTree()
+	{
+		swap(other);
+	}
+	
+	~RadixTree()
+	{
+		clear();
+	}
+	
+	RadixTree &operator=(const RadixTree &other) = delete;
+	
+	RadixTree &operator=(RadixTree &&other) noexcept
+	{
+		swap(other);
+		return *this;
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	// Bytes taken by the nodes and leaves of the tree, not counting memory the keys own.
+	SizeType memory_usage() const noexcept
+	{
+		return m_node_counts[0] * sizeof(Leaf) + m_node_counts[1] * sizeof(Node4) + m_node_counts[2] * sizeof(Node16)
+			+ m_node_counts[3] * sizeof(Node48) + m_node_counts[4] * sizeof(Node256);
+	}
+	
+	void clear()
+	{
+		if(m_root != nullptr)
+		{
+			delete_subtree(m_root);
+		}
+		m_root = nullptr;
+		m_length = 0;
+	}
+	
+	bool contains(const KeyType &key) const
+	{
+		return find(key) != nullptr;
+	}
+	
+	const ValueType &get(const KeyType &key) const
+	{
+		const Leaf *leaf = find(key);
+		if(leaf == nullptr)
+		{
+			throw std::out_of_range("");
+		}
+		return leaf -> value;
+	}
+	
+	ValueType &get(const KeyType &key)
+	{
+		return const_cast<ValueType &>(static_cast<const RadixTree *>(this) -> get(key));
+	}
+	
+	// Inserts the key, or overwrites its value when it is already present.
+	void set(const KeyType &key, const ValueType &value)
+	{
+		KeyBytes bytes(key);
+		Node **slot = &m_root;
+		SizeType depth = 0;
+		for(;;)
+		{
+			Node *node = *slot;
+			if(node == nullptr)
+			{
+				*slot = new_leaf(key, value);
+				++m_length;
+				return;
+			}
+			if(node -> type == NodeType::LEAF)
+			{
+				Leaf *leaf = static_cast<Leaf *>(node);
+				if(leaf -> key == key)
+				{
+					leaf -> value = value;
+					return;
+				}
+				*slot = split_leaf(leaf, bytes, depth, new_leaf(key, value));
+				++m_length;
+				return;
+			}
+			Inner *inner = static_cast<Inner *>(node);
+			if(inner -> prefix_length > 0)
+			{
+				SizeType matched = prefix_mismatch(inner, bytes, depth);
+				if(matched < inner -> prefix_length)
+				{
+					*slot = split_prefix(inner, bytes, depth, matched, new_leaf(key, value));
+					++m_length;
+					return;
+				}
+				depth += inner -> prefix_length;
+			}
+			if(depth == bytes.length())
+			{
+				if(inner -> terminal != nullptr)
+				{
+					inner -> terminal -> value = value;
+				}
+				else
+				{
+					inner -> terminal = new_leaf(key, value);
+					++m_length;
+				}
+				return;
+			}
+			Node **child = find_child(inner, bytes[depth]);
+			if(child == nullptr)
+			{
+				add_child(slot, bytes[depth], new_leaf(key, value));
+				++m_length;
+				return;
+			}
+			slot = child;
+			++depth;
+		}
+	}
+	
+	void remove(const KeyType &key)
+	{
+		KeyBytes bytes(key);
+		if(!erase(&m_root, key, bytes, 0))
+		{
+			throw std::out_of_range("");
+		}
+		--m_length;
+	}
+	
+	// Calls func(key, value) for every element, in ascending key order.
+	template<class Func>
+	void for_each(Func func) const
+	{
+		if(m_root != nullptr)
+		{
+			visit(m_root, func);
+		}
+	}
+	
+	// Calls func(key, value), in ascending key order, for every element whose key starts with the
+	// first prefix_length bytes of prefix_key, e.g. all addresses of a subnet for integer keys.
+	template<class Func>
+	void for_each_with_prefix(const KeyType &prefix_key, SizeType prefix_length, Func func) const
+	{
+		KeyBytes prefix(prefix_key);
+		if(prefix_length > prefix.length())
+		{
+			throw std::invalid_argument("");
+		}
+		const Node *node = m_root;
+		SizeType depth = 0;
+		while(node != nullptr && node -> type != NodeType::LEAF)
+		{
+			const Inner *inner = static_cast<const Inner *>(node);
+			if(depth + inner -> prefix_length >= prefix_length)
+			{
+				break;
+			}
+			depth += inner -> prefix_length;
+			Node *const *child = find_child(const_cast<Inner *>(inner), prefix[depth]);
+			node = child == nullptr ? nullptr : *child;
+			++depth;
+		}
+		// every key below the node shares its path, so one of them shows whether the prefix matched
+		if(node != nullptr && starts_with(any_leaf(node) -> key, prefix, prefix_length))
+		{
+			visit(node, func);
+		}
+	}
+	
+	// All the elements whose keys start with the prefix, which for string keys is the usual meaning.
+	template<class Func>
+	void for_each_with_prefix(const KeyType &prefix, Func func) const
+	{
+		for_each_with_prefix(prefix, KeyBytes(prefix).length(), func);
+	}
+	
+private:
+	
+	void swap(RadixTree &other) noexcept
+	{
+		std::swap(m_root, other.m_root);
+		std::swap(m_length, other.m_length);
+		std::swap(m_node_counts, other.m_node_counts);
+	}
+	
+	Leaf *new_leaf(const KeyType &key, const ValueType &value)
+	{
+		Leaf *leaf = new Leaf();
+		leaf -> type = NodeType::LEAF;
+		leaf -> key = key;
+		leaf -> value = value;
+		++m_node_counts[0];
+		return leaf;
+	}
+	
+	template<class NodeKind>
+	NodeKind *new_inner(NodeType type)
+	{
+		NodeKind *inner = new NodeKind();
+		inner -> type = type;
+		inner -> count = 0;
+		inner -> prefix_length = 0;
+		inner -> terminal = nullptr;
+		++m_node_counts[static_cast<SizeType>(type)];
+		return inner;
+	}
+	
+	// Copies the header of one inner node to another of a different size.
+	static void copy_header(Inner *to, const Inner *from) noexcept
+	{
+		to -> count = from -> count;
+		to -> prefix_length = from -> prefix_length;
+		std::memcpy(to -> prefix, from -> prefix, MAX_PREFIX);
+		to -> terminal = from -> terminal;
+	}
+	
+	void delete_node(Node *node)
+	{
+		--m_node_counts[static_cast<SizeType>(node -> type)];
+		switch(node -> type)
+		{
+			case NodeType::LEAF: delete static_cast<Leaf *>(node); break;
+			case NodeType::NODE4: delete static_cast<Node4 *>(node); break;
+			case NodeType::NODE16: delete static_cast<Node16 *>(node); break;
+			case NodeType::NODE48: delete static_cast<Node48 *>(node); break;
+			case NodeType::NODE256: delete static_cast<Node256 *>(node); break;
+		}
+	}
+	
+	void delete_subtree(Node *node)
+	{
+		if(node -> type != NodeType::LEAF)
+		{
+			Inner *inner = static_cast<Inner *>(node);
+			if(inner -> terminal != nullptr)
+			{
+				delete_node(inner -> terminal);
+			}
+			for_each_child(inner, [this](unsigned char, Node *child)
+			{
+				delete_subtree(child);
+			});
+		}
+		delete_node(node);
+	}
+	
+	static bool starts_with(const KeyType &key, const KeyBytes &prefix, SizeType prefix_length) noexcept
+	{
+		KeyBytes bytes(key);
+		return bytes.length() >= prefix_length && std::memcmp(bytes.data(), prefix.data(), prefix_length) == 0;
+	}
+	
+	// The terminal leaf if there is one, otherwise a leaf of the first child.
+	static const Leaf *any_leaf(const Node *node) noexcept
+	{
+		while(node -> type != NodeType::LEAF)
+		{
+			const Inner *inner = static_cast<const Inner *>(node);
+			if(inner -> terminal != nullptr)
+			{
+				return inner -> terminal;
+			}
+			for_each_child(const_cast<Inner *>(inner), [&node](unsigned char, Node *child)
+			{
+				node = child;
+				return false;
+			});
+		}
+		return static_cast<const Leaf *>(node);
+	}
+	
+	const Leaf *find(const KeyType &key) const
+	{
+		KeyBytes bytes(key);
+		const Node *node = m_root;
+		SizeType depth = 0;
+		while(node != nullptr)
+		{
+			if(node -> type == NodeType::LEAF)
+			{
+				const Leaf *leaf = static_cast<const Leaf *>(node);
+				return leaf -> key == key ? leaf : nullptr;
+			}
+			const Inner *inner = static_cast<const Inner *>(node);
+			// only the stored part of the prefix is compared; the leaf check covers the rest
+			SizeType stored = inner -> prefix_length < MAX_PREFIX ? inner -> prefix_length : MAX_PREFIX;
+			if(depth + inner -> prefix_length > bytes.length() || std::memcmp(inner -> prefix, bytes.data() + depth, stored) != 0)
+			{
+				return nullptr;
+			}
+			depth += inner -> prefix_length;
+			if(depth == bytes.length())
+			{
+				return inner -> terminal != nullptr && inner -> terminal -> key == key ? inner -> terminal : nullptr;
+			}
+			Node *const *child = find_child(const_cast<Inner *>(inner), bytes[depth]);
+			node = child == nullptr ? nullptr : *child;
+			++depth;
+		}
+		return nullptr;
+	}
+	
+	// The number of leading bytes of the node's prefix that match the key from depth on. Bytes
+	// past the stored part are read from a leaf below the node.
+	static SizeType prefix_mismatch(const Inner *inner, const KeyBytes &bytes, SizeType depth) noexcept
+	{
+		SizeType limit = inner -> prefix_length < bytes.length() - depth ? inner -> prefix_length : bytes.length() - depth;
+		SizeType stored = limit < MAX_PREFIX ? limit : MAX_PREFIX;
+		for(SizeType i = 0; i < stored; ++i)
+		{
+			if(inner -> prefix[i] != bytes[depth + i])
+			{
+				return i;
+			}
+		}
+		if(limit > MAX_PREFIX)
+		{
+			KeyBytes leaf_bytes(any_leaf(inner) -> key);
+			for(SizeType i = MAX_PREFIX; i < limit; ++i)
+			{
+				if(leaf_bytes[depth + i] != bytes[depth + i])
+				{
+					return i;
+				}
+			}
+		}
+		return limit;
+	}
+	
+	// Stores the bytes at from .. from + length as the node's prefix.
+	static void set_prefix(Inner *inner, const unsigned char *from, SizeType length) noexcept
+	{
+		inner -> prefix_length = static_cast<std::uint32_t>(length);
+		std::memcpy(inner -> prefix, from, length < MAX_PREFIX ? length : MAX_PREFIX);
+	}
+	
+	// Puts a leaf under a Node4 by its byte at depth, or into its terminal slot when its key ends there.
+	void attach(Node4 *node, Leaf *leaf, SizeType depth)
+	{
+		KeyBytes bytes(leaf -> key);
+		if(depth == bytes.length())
+		{
+			node -> terminal = leaf;
+		}
+		else
+		{
+			Node *slot = node;
+			add_child(&slot, bytes[depth], leaf);
+		}
+	}
+	
+	// Replaces a leaf met on the way down with a Node4 holding it and the new leaf, prefixed by
+	// whatever the two keys still have in common.
+	Node *split_leaf(Leaf *leaf, const KeyBytes &bytes, SizeType depth, Leaf *added)
+	{
+		KeyBytes leaf_bytes(leaf -> key);
+		SizeType common = 0;
+		while(depth + common < bytes.length() && depth + common < leaf_bytes.length() && bytes[depth + common] == leaf_bytes[depth + common])
+		{
+			++common;
+		}
+		Node4 *node = new_inner<Node4>(NodeType::NODE4);
+		set_prefix(node, bytes.data() + depth, common);
+		attach(node, leaf, depth + common);
+		attach(node, added, depth + common);
+		return node;
+	}
+	
+	// Splits the prefix of a node where the new key departs from it: a new Node4 takes the matched
+	// part of the prefix, and the old node keeps what follows the byte that now leads to it.
+	Node *split_prefix(Inner *inner, const KeyBytes &bytes, SizeType depth, SizeType matched, Leaf *added)
+	{
+		Node4 *node = new_inner<Node4>(NodeType::NODE4);
+		set_prefix(node, bytes.data() + depth, matched);
+		SizeType remaining = inner -> prefix_length - matched - 1;
+		unsigned char branch;
+		if(inner -> prefix_length <= MAX_PREFIX)
+		{
+			branch = inner -> prefix[matched];
+			std::memmove(inner -> prefix, inner -> prefix + matched + 1, remaining);
+			inner -> prefix_length = static_cast<std::uint32_t>(remaining);
+		}
+		else
+		{
+			// the bytes past the stored part are only known from a leaf
+			KeyBytes leaf_bytes(any_leaf(inner) -> key);
+			branch = leaf_bytes[depth + matched];
+			set_prefix(inner, leaf_bytes.data() + depth + matched + 1, remaining);
+		}
+		Node *slot = node;
+		add_child(&slot, branch, inner);
+		attach(node, added, depth + matched);
+		return node;
+	}
+	
+	// Index of the child for the byte in a Node16, comparing all sixteen keys at once.
+	static int node16_position(const Node16 *node, unsigned char byte) noexcept
+	{
+		BytesType keys;
+		std::memcpy(&keys, node -> keys, sizeof(keys));
+		BytesType lanes = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+		auto equal = (keys == (BytesType{} + byte)) & (lanes < static_cast<unsigned char>(node -> count));
+		// each matching lane is a 0xFF byte; on a little-endian target the lowest one is the first match
+		std::uint64_t halves[2];
+		std::memcpy(halves, &equal, sizeof(halves));
+		if(halves[0] != 0)
+		{
+			return std::countr_zero(halves[0]) / 8;
+		}
+		if(halves[1] != 0)
+		{
+			return 8 + std::countr_zero(halves[1]) / 8;
+		}
+		return -1;
+	}
+	
+	static Node **find_child(Inner *inner, unsigned char byte) noexcept
+	{
+		switch(inner -> type)
+		{
+			case NodeType::NODE4:
+			{
+				Node4 *node = static_cast<Node4 *>(inner);
+				for(SizeType i = 0; i < node -> count; ++i)
+				{
+					if(node -> keys[i] == byte)
+					{
+						return &node -> children[i];
+					}
+				}
+				return nullptr;
+			}
+			case NodeType::NODE16:
+			{
+				Node16 *node = static_cast<Node16 *>(inner);
+				int pos = node16_position(node, byte);
+				return pos < 0 ? nullptr : &node -> children[pos];
+			}
+			case NodeType::NODE48:
+			{
+				Node48 *node = static_cast<Node48 *>(inner);
+				return node -> index[byte] == 0 ? nullptr : &node -> children[node -> index[byte] - 1];
+			}
+			case NodeType::NODE256:
+			{
+				Node256 *node = static_cast<Node256 *>(inner);
+				return node -> children[byte] == nullptr ? nullptr : &node -> children[byte];
+			}
+			default:
+				return nullptr;
+		}
+	}
+	
+	// Calls func(byte, child) for the children in byte order, until func returns false if it returns bool.
+	template<class Func>
+	static void for_each_child(Inner *inner, Func func)
+	{
+		auto call = [&func](unsigned char byte, Node *child)
+		{
+			if constexpr(std::is_same_v<decltype(func(byte, child)), bool>)
+			{
+				return func(byte, child);
+			}
+			else
+			{
+				func(byte, child);
+				return true;
+			}
+		};
+		switch(inner -> type)
+		{
+			case NodeType::NODE4:
+			{
+				Node4 *node = static_cast<Node4 *>(inner);
+				for(SizeType i = 0; i < node -> count && call(node -> keys[i], node -> children[i]); ++i);
+				break;
+			}
+			case NodeType::NODE16:
+			{
+				Node16 *node = static_cast<Node16 *>(inner);
+				for(SizeType i = 0; i < node -> count && call(node -> keys[i], node -> children[i]); ++i);
+				break;
+			}
+			case NodeType::NODE48:
+			{
+				Node48 *node = static_cast<Node48 *>(inner);
+				for(SizeType byte = 0; byte < 256; ++byte)
+				{
+					if(node -> index[byte] != 0 && !call(static_cast<unsigned char>(byte), node -> children[node -> index[byte] - 1]))
+					{
+						break;
+					}
+				}
+				break;
+			}
+			case NodeType::NODE256:
+			{
+				Node256 *node = static_cast<Node256 *>(inner);
+				for(SizeType byte = 0; byte < 256; ++byte)
+				{
+					if(node -> children[byte] != nullptr && !call(static_cast<unsigned char>(byte), node -> children[byte]))
+					{
+						break;
+					}
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+	
+	// Inserts into a sorted key array, shifting the larger keys and their children up.
+	template<class NodeKind>
+	static void insert_sorted(NodeKind *node, unsigned char byte, Node *child) noexcept
+	{
+		SizeType pos = 0;
+		while(pos < node -> count && node -> keys[pos] < byte)
+		{
+			++pos;
+		}
+		for(SizeType i = node -> count; i > pos; --i)
+		{
+			node -> keys[i] = node -> keys[i - 1];
+			node -> children[i] = node -> children[i - 1];
+		}
+		node -> keys[pos] = byte;
+		node -> children[pos] = child;
+		++node -> count;
+	}
+	
+	// Adds a child for a byte the node has none for, first growing the node into the next size when
+	// it is full; slot is where the node hangs and is updated when it is replaced.
+	void add_child(Node **slot, unsigned char byte, Node *child)
+	{
+		Inner *inner = static_cast<Inner *>(*slot);
+		switch(inner -> type)
+		{
+			case NodeType::NODE4:
+			{
+				Node4 *node = static_cast<Node4 *>(inner);
+				if(node -> count < 4)
+				{
+					insert_sorted(node, byte, child);
+					return;
+				}
+				Node16 *grown = new_inner<Node16>(NodeType::NODE16);
+				copy_header(grown, node);
+				std::memcpy(grown -> keys, node -> keys, 4);
+				std::memcpy(grown -> children, node -> children, 4 * sizeof(Node *));
+				insert_sorted(grown, byte, child);
+				*slot = grown;
+				delete_node(node);
+				return;
+			}
+			case NodeType::NODE16:
+			{
+				Node16 *node = static_cast<Node16 *>(inner);
+				if(node -> count < 16)
+				{
+					insert_sorted(node, byte, child);
+					return;
+				}
+				Node48 *grown = new_inner<Node48>(NodeType::NODE48);
+				copy_header(grown, node);
+				for(SizeType i = 0; i < 16; ++i)
+				{
+					grown -> index[node -> keys[i]] = static_cast<unsigned char>(i + 1);
+					grown -> children[i] = node -> children[i];
+				}
+				grown -> index[byte] = 17;
+				grown -> children[16] = child;
+				++grown -> count;
+				*slot = grown;
+				delete_node(node);
+				return;
+			}
+			case NodeType::NODE48:
+			{
+				Node48 *node = static_cast<Node48 *>(inner);
+				if(node -> count < 48)
+				{
+					// slots are not kept packed after removals, so look for a free one
+					SizeType free = 0;
+					while(node -> children[free] != nullptr)
+					{
+						++free;
+					}
+					node -> children[free] = child;
+					node -> index[byte] = static_cast<unsigned char>(free + 1);
+					++node -> count;
+					return;
+				}
+				Node256 *grown = new_inner<Node256>(NodeType::NODE256);
+				copy_header(grown, node);
+				for(SizeType i = 0; i < 256; ++i)
+				{
+					if(node -> index[i] != 0)
+					{
+						grown -> children[i] = node -> children[node -> index[i] - 1];
+					}
+				}
+				grown -> children[byte] = child;
+				++grown -> count;
+				*slot = grown;
+				delete_node(node);
+				return;
+			}
+			case NodeType::NODE256:
+			{
+				Node256 *node = static_cast<Node256 *>(inner);
+				node -> children[byte] = child;
+				++node -> count;
+				return;
+			}
+			default:
+				return;
+		}
+	}
+	
+	// Removes the child for the byte; the caller shrinks the node afterwards.
+	static void remove_child(Inner *inner, unsigned char byte) noexcept
+	{
+		switch(inner -> type)
+		{
+			case NodeType::NODE4:
+			case NodeType::NODE16:
+			{
+				unsigned char *keys = inner -> type == NodeType::NODE4 ? static_cast<Node4 *>(inner) -> keys : static_cast<Node16 *>(inner) -> keys;
+				Node **children = inner -> type == NodeType::NODE4 ? static_cast<Node4 *>(inner) -> children : static_cast<Node16 *>(inner) -> children;
+				SizeType pos = 0;
+				while(keys[pos] != byte)
+				{
+					++pos;
+				}
+				for(SizeType i = pos + 1; i < inner -> count; ++i)
+				{
+					keys[i - 1] = keys[i];
+					children[i - 1] = children[i];
+				}
+				break;
+			}
+			case NodeType::NODE48:
+			{
+				Node48 *node = static_cast<Node48 *>(inner);
+				node -> children[node -> index[byte] - 1] = nullptr;
+				node -> index[byte] = 0;
+				break;
+			}
+			case NodeType::NODE256:
+			{
+				static_cast<Node256 *>(inner) -> children[byte] = nullptr;
+				break;
+			}
+			default:
+				break;
+		}
+		--inner -> count;
+	}
+	
+	// Moves a node into the next smaller size once it is well under its capacity (leaving some
+	// room, so that one add and one remove at the border do not keep resizing it), and collapses
+	// a Node4 that has a single thing left in it into that thing.
+	void shrink(Node **slot)
+	{
+		Inner *inner = static_cast<Inner *>(*slot);
+		switch(inner -> type)
+		{
+			case NodeType::NODE4:
+			{
+				Node4 *node = static_cast<Node4 *>(inner);
+				if(node -> count == 0)
+				{
+					// only the terminal is left, and a leaf does not need the path above it
+					*slot = node -> terminal;
+					delete_node(node);
+				}
+				else if(node -> count == 1 && node -> terminal == nullptr)
+				{
+					collapse(slot, node);
+				}
+				return;
+			}
+			case NodeType::NODE16:
+			{
+				Node16 *node = static_cast<Node16 *>(inner);
+				if(node -> count > 3)
+				{
+					return;
+				}
+				Node4 *shrunk = new_inner<Node4>(NodeType::NODE4);
+				copy_header(shrunk, node);
+				std::memcpy(shrunk -> keys, node -> keys, node -> count);
+				std::memcpy(shrunk -> children, node -> children, node -> count * sizeof(Node *));
+				*slot = shrunk;
+				delete_node(node);
+				return;
+			}
+			case NodeType::NODE48:
+			{
+				Node48 *node = static_cast<Node48 *>(inner);
+				if(node -> count > 12)
+				{
+					return;
+				}
+				Node16 *shrunk = new_inner<Node16>(NodeType::NODE16);
+				copy_header(shrunk, node);
+				shrunk -> count = 0;
+				for(SizeType i = 0; i < 256; ++i)
+				{
+					if(node -> index[i] != 0)
+					{
+						shrunk -> keys[shrunk -> count] = static_cast<unsigned char>(i);
+						shrunk -> children[shrunk -> count] = node -> children[node -> index[i] - 1];
+						++shrunk -> count;
+					}
+				}
+				*slot = shrunk;
+				delete_node(node);
+				return;
+			}
+			case NodeType::NODE256:
+			{
+				Node256 *node = static_cast<Node256 *>(inner);
+				if(node -> count > 37)
+				{
+					return;
+				}
+				Node48 *shrunk = new_inner<Node48>(NodeType::NODE48);
+				copy_header(shrunk, node);
+				shrunk -> count = 0;
+				for(SizeType i = 0; i < 256; ++i)
+				{
+					if(node -> children[i] != nullptr)
+					{
+						shrunk -> children[shrunk -> count] = node -> children[i];
+						shrunk -> index[i] = static_cast<unsigned char>(shrunk -> count + 1);
+						++shrunk -> count;
+					}
+				}
+				*slot = shrunk;
+				delete_node(node);
+				return;
+			}
+			default:
+				return;
+		}
+	}
+	
+	// Replaces a Node4 with its only child; an inner child takes over the node's prefix and the
+	// byte that led to it in front of its own prefix.
+	void collapse(Node **slot, Node4 *node)
+	{
+		Node *child = node -> children[0];
+		if(child -> type != NodeType::LEAF)
+		{
+			Inner *inner = static_cast<Inner *>(child);
+			unsigned char prefix[MAX_PREFIX];
+			SizeType length = node -> prefix_length < MAX_PREFIX ? node -> prefix_length : MAX_PREFIX;
+			std::memcpy(prefix, node -> prefix, length);
+			if(length < MAX_PREFIX)
+			{
+				prefix[length++] = node -> keys[0];
+			}
+			SizeType child_stored = inner -> prefix_length < MAX_PREFIX ? inner -> prefix_length : MAX_PREFIX;
+			for(SizeType i = 0; length < MAX_PREFIX && i < child_stored; ++i)
+			{
+				prefix[length++] = inner -> prefix[i];
+			}
+			std::memcpy(inner -> prefix, prefix, length);
+			inner -> prefix_length += node -> prefix_length + 1;
+		}
+		*slot = child;
+		delete_node(node);
+	}
+	
+	// Returns whether the key was found and removed.
+	bool erase(Node **slot, const KeyType &key, const KeyBytes &bytes, SizeType depth)
+	{
+		Node *node = *slot;
+		if(node == nullptr)
+		{
+			return false;
+		}
+		if(node -> type == NodeType::LEAF)
+		{
+			if(!(static_cast<Leaf *>(node) -> key == key))
+			{
+				return false;
+			}
+			*slot = nullptr;
+			delete_node(node);
+			return true;
+		}
+		Inner *inner = static_cast<Inner *>(node);
+		SizeType stored = inner -> prefix_length < MAX_PREFIX ? inner -> prefix_length : MAX_PREFIX;
+		if(depth + inner -> prefix_length > bytes.length() || std::memcmp(inner -> prefix, bytes.data() + depth, stored) != 0)
+		{
+			return false;
+		}
+		depth += inner -> prefix_length;
+		if(depth == bytes.length())
+		{
+			if(inner -> terminal == nullptr || !(inner -> terminal -> key == key))
+			{
+				return false;
+			}
+			delete_node(inner -> terminal);
+			inner -> terminal = nullptr;
+			shrink(slot);
+			return true;
+		}
+		Node **child = find_child(inner, bytes[depth]);
+		if(child == nullptr)
+		{
+			return false;
+		}
+		if((*child) -> type == NodeType::LEAF)
+		{
+			if(!(static_cast<Leaf *>(*child) -> key == key))
+			{
+				return false;
+			}
+			delete_node(*child);
+			remove_child(inner, bytes[depth]);
+			shrink(slot);
+			return true;
+		}
+		return erase(child, key, bytes, depth + 1);
+	}
+	
+	template<class Func>
+	static void visit(const Node *node, Func &func)
+	{
+		if(node -> type == NodeType::LEAF)
+		{
+			Leaf *leaf = const_cast<Leaf *>(static_cast<const Leaf *>(node));
+			func(static_cast<const KeyType &>(leaf -> key), leaf -> value);
+			return;
+		}
+		Inner *inner = const_cast<Inner *>(static_cast<const Inner *>(node));
+		// a key ending here is a prefix of all the others below, so it comes first
+		if(inner -> terminal != nullptr)
+		{
+			func(static_cast<const KeyType &>(inner -> terminal -> key), inner -> terminal -> value);
+		}
+		for_each_child(inner, [&func](unsigned char, Node *child)
+		{
+			visit(child, func);
+		});
+	}
+};
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef SegmentedVector_HPP
+#define SegmentedVector_HPP
+
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+// Vector whose elements never move. Storage is a table of blocks that double in size (FIRST_BLOCK_SIZE,
+// FIRST_BLOCK_SIZE, 2 * FIRST_BLOCK_SIZE, ...), so growing allocates one new block instead of copying
+// everything, pointers to elements stay valid for as long as the elements exist, and a position
+// is turned into a block and an offset with one bit scan. Shrinking frees whole blocks, keeping
+// at most one empty block around so that adding and removing at a block boundary does not thrash.
+template<class Elem>
+class SegmentedVector
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Elem ElementType;
+	
+	static constexpr SizeType FIRST_BLOCK_BITS = 4;
+	static constexpr SizeType FIRST_BLOCK_SIZE = SizeType(1) << FIRST_BLOCK_BITS;
+	
+private:
+	
+	static constexpr SizeType MAX_BLOCKS = sizeof(SizeType) * 8 - FIRST_BLOCK_BITS + 1;
+	
+	struct Location
+	{
+		SizeType block, offset;
+	};
+	
+	template<class Pointee>
+	class SegmentedVectorIterator;
+	
+public:
+	
+	typedef SegmentedVectorIterator<ElementType> IteratorType;
+	typedef SegmentedVectorIterator<const ElementType> ConstIteratorType;
+	
+private:
+	
+	ElementType *m_blocks[MAX_BLOCKS];
+	SizeType m_block_count, m_length;
+	
+public:
+	
+	SegmentedVector() noexcept
+		: m_blocks(), m_block_count(0), m_length(0)
+	{}
+	
+	SegmentedVector(std::initializer_list<ElementType> elements)
+		: SegmentedVector()
+	{
+		for(const ElementType &value : elements)
+		{
+			add_back(value);
+		}
+	}
+	
+	SegmentedVector(const SegmentedVector &other)
+		: SegmentedVector()
+	{
+		for(SizeType i = 0; i < other.m_length; ++i)
+		{
+			add_back(other.get(i));
+		}
+	}
+	
+	SegmentedVector(SegmentedVector &&other) noexcept
+		: SegmentedVector()
+	{
+		swap(other);
+	}
+	
+	~SegmentedVector()
+	{
+		release_blocks(0);
+	}
+	
+	SegmentedVector &operator=(SegmentedVector other) noexcept
+	{
+		swap(other);
+		return *this;
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	SizeType capacity() const noexcept
+	{
+		return m_block_count == 0 ? 0 : FIRST_BLOCK_SIZE << (m_block_count - 1);
+	}
+	
+	void clear()
+	{
+		release_blocks(0);
+		m_length = 0;
+	}
+	
+	void add_back(const ElementType &value)
+	{
+		Location location = locate(m_length);
+		if(location.block == m_block_count)
+		{
+			m_blocks[m_block_count] = new ElementType[block_size(m_block_count)];
+			++m_block_count;
+		}
+		m_blocks[location.block][location.offset] = value;
+		++m_length;
+	}
+	
+	void remove_back()
+	{
+		if(m_length == 0)
+		{
+			throw std::out_of_range("");
+		}
+		--m_length;
+		// keep the block the next element would go to, free any after it
+		release_blocks(locate(m_length).block + 1);
+	}
+	
+	ElementType &get(SizeType pos)
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		return at(pos);
+	}
+	
+	const ElementType &get(SizeType pos) const
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		return at(pos);
+	}
+	
+	ElementType &get_back()
+	{
+		if(m_length == 0)
+		{
+			throw std::out_of_range("");
+		}
+		return at(m_length - 1);
+	}
+	
+	const ElementType &get_back() const
+	{
+		if(m_length == 0)
+		{
+			throw std::out_of_range("");
+		}
+		return at(m_length - 1);
+	}
+	
+	ElementType &get_front()
+	{
+		return get(0);
+	}
+	
+	const ElementType &get_front() const
+	{
+		return get(0);
+	}
+	
+	void set(SizeType pos, const ElementType &value)
+	{
+		get(pos) = value;
+	}
+	
+	void set_back(const ElementType &value)
+	{
+		get_back() = value;
+	}
+	
+	void set_front(const ElementType &value)
+	{
+		get_front() = value;
+	}
+	
+	IteratorType begin() noexcept
+	{
+		return IteratorType(m_blocks, 0);
+	}
+	
+	ConstIteratorType cbegin() const noexcept
+	{
+		return ConstIteratorType(m_blocks, 0);
+	}
+	
+	IteratorType end() noexcept
+	{
+		return IteratorType(m_blocks, m_length);
+	}
+	
+	ConstIteratorType cend() const noexcept
+	{
+		return ConstIteratorType(m_blocks, m_length);
+	}
+	
+private:
+	
+	static constexpr SizeType block_size(SizeType block) noexcept
+	{
+		return block == 0 ? FIRST_BLOCK_SIZE : FIRST_BLOCK_SIZE << (block - 1);
+	}
+	
+	// Block k > 0 starts at position FIRST_BLOCK_SIZE << (k - 1), so it is found from the highest set bit.
+	static constexpr Location locate(SizeType pos) noexcept
+	{
+		if(pos < FIRST_BLOCK_SIZE)
+		{
+			return Location{ .block = 0, .offset = pos };
+		}
+		SizeType high_bit = std::bit_width(pos) - 1;
+		return Location{ .block = high_bit - FIRST_BLOCK_BITS + 1, .offset = pos - (SizeType(1) << high_bit) };
+	}
+	
+	ElementType &at(SizeType pos) const noexcept
+	{
+		Location location = locate(pos);
+		return m_blocks[location.block][location.offset];
+	}
+	
+	void release_blocks(SizeType first_block) noexcept
+	{
+		while(m_block_count > first_block)
+		{
+			--m_block_count;
+			delete[] m_blocks[m_block_count];
+			m_blocks[m_block_count] = nullptr;
+		}
+	}
+	
+	void swap(SegmentedVector &other) noexcept
+	{
+		std::swap(m_blocks, other.m_blocks);
+		std::swap(m_block_count, other.m_block_count);
+		std::swap(m_length, other.m_length);
+	}
+	
+	// Walks the elements in order, stepping to the next block pointer when a block ends.
+	template<class Pointee>
+	class SegmentedVectorIterator
+	{
+		ElementType *const *m_block;
+		Pointee *m_element, *m_block_end;
+		SizeType m_pos;
+		
+	public:
+		
+		SegmentedVectorIterator(ElementType *const *blocks, SizeType pos) noexcept
+			: m_block(blocks + locate(pos).block),
+			m_element(nullptr),
+			m_block_end(nullptr),
+			m_pos(pos)
+		{
+			Location location = locate(pos);
+			if(*m_block != nullptr)
+			{
+				m_element = *m_block + location.offset;
+				m_block_end = *m_block + block_size(location.block);
+			}
+		}
+		
+		Pointee &operator*() const noexcept
+		{
+			return *m_element;
+		}
+		
+		bool operator==(const SegmentedVectorIterator &other) const noexcept
+		{
+			return m_pos == other.m_pos;
+		}
+		
+		bool operator!=(const SegmentedVectorIterator &other) const noexcept
+		{
+			return m_pos != other.m_pos;
+		}
+		
+		SegmentedVectorIterator &operator++() noexcept
+		{
+			++m_pos;
+			if(++m_element == m_block_end)
+			{
+				// the next block may not exist yet when this is the end iterator
+				SizeType next_size = (m_block_end - *m_block) * (m_pos == FIRST_BLOCK_SIZE ? 1 : 2);
+				++m_block;
+				m_element = *m_block;
+				m_block_end = m_element == nullptr ? nullptr : m_element + next_size;
+			}
+			return *this;
+		}
+		
+		SegmentedVectorIterator operator++(int) noexcept
+		{
+			SegmentedVectorIterator unincremented = *this;
+			++*this;
+			return unincremented;
+		}
+	};
+};
+
+#endif
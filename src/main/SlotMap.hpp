@@ -0,0 +1,170 @@
+#ifndef SlotMap_HPP
+#define SlotMap_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "Vector.hpp"
+
+// Container that hands out stable handles to its elements while keeping the elements packed in
+// one Vector. A handle names a slot and the generation of that slot; the slot holds the position
+// of the element, and removing an element moves the last one into its place and bumps the
+// generation, so add and remove are O(1), iteration is a plain array walk in no particular order,
+// and a handle to a removed element is recognised instead of reaching another element.
+template<class Elem>
+class SlotMap
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef Elem ElementType;
+	typedef ElementType *IteratorType;
+	typedef const ElementType *ConstIteratorType;
+	
+	struct Handle
+	{
+		std::uint32_t index, generation;
+		
+		bool operator==(const Handle &other) const noexcept
+		{
+			return index == other.index && generation == other.generation;
+		}
+	};
+	
+private:
+	
+	static constexpr std::uint32_t NONE = ~std::uint32_t(0);
+	
+	// position holds the element's position while the slot is used, and the next free slot after that
+	struct Slot
+	{
+		std::uint32_t position, generation;
+	};
+	
+	Vector<ElementType> m_elements;
+	Vector<std::uint32_t> m_element_slots;
+	Vector<Slot> m_slots;
+	std::uint32_t m_free;
+	
+public:
+	
+	SlotMap()
+		: m_elements(), m_element_slots(), m_slots(), m_free(NONE)
+	{}
+	
+	SizeType count() const noexcept
+	{
+		return m_elements.count();
+	}
+	
+	// False once the element is removed, even when its slot has been reused.
+	bool contains(Handle handle) const
+	{
+		return handle.index < m_slots.count() && m_slots.get(handle.index).generation == handle.generation;
+	}
+	
+	Handle add(const ElementType &value)
+	{
+		if(m_elements.count() == NONE)
+		{
+			throw std::length_error("");
+		}
+		std::uint32_t index = m_free;
+		if(index != NONE)
+		{
+			m_free = m_slots.get(index).position;
+		}
+		else
+		{
+			index = static_cast<std::uint32_t>(m_slots.count());
+			m_slots.add_back(Slot{ .position = NONE, .generation = 0 });
+		}
+		Slot &slot = m_slots.get(index);
+		slot.position = static_cast<std::uint32_t>(m_elements.count());
+		m_elements.add_back(value);
+		m_element_slots.add_back(index);
+		return Handle{ .index = index, .generation = slot.generation };
+	}
+	
+	const ElementType &get(Handle handle) const
+	{
+		if(!contains(handle))
+		{
+			throw std::out_of_range("");
+		}
+		return m_elements.get(m_slots.get(handle.index).position);
+	}
+	
+	ElementType &get(Handle handle)
+	{
+		return const_cast<ElementType &>(static_cast<const SlotMap *>(this) -> get(handle));
+	}
+	
+	void set(Handle handle, const ElementType &value)
+	{
+		get(handle) = value;
+	}
+	
+	// Moves the last element into the gap, so other elements may change position but keep their handles.
+	void remove(Handle handle)
+	{
+		if(!contains(handle))
+		{
+			throw std::out_of_range("");
+		}
+		Slot &slot = m_slots.get(handle.index);
+		std::uint32_t position = slot.position;
+		std::uint32_t last = static_cast<std::uint32_t>(m_elements.count() - 1);
+		if(position != last)
+		{
+			m_elements.get(position) = std::move(m_elements.get(last));
+			m_element_slots.set(position, m_element_slots.get(last));
+			m_slots.get(m_element_slots.get(position)).position = position;
+		}
+		m_elements.remove_back();
+		m_element_slots.remove_back();
+		++slot.generation;
+		slot.position = m_free;
+		m_free = handle.index;
+	}
+	
+	// Every handle handed out so far goes stale.
+	void clear()
+	{
+		while(m_elements.count() > 0)
+		{
+			remove(handle_at(m_elements.count() - 1));
+		}
+	}
+	
+	// The handle of the element at the given position of the iteration order.
+	Handle handle_at(SizeType pos) const
+	{
+		std::uint32_t index = m_element_slots.get(pos);
+		return Handle{ .index = index, .generation = m_slots.get(index).generation };
+	}
+	
+	IteratorType begin() noexcept
+	{
+		return m_elements.begin();
+	}
+	
+	ConstIteratorType cbegin() const noexcept
+	{
+		return m_elements.cbegin();
+	}
+	
+	IteratorType end() noexcept
+	{
+		return m_elements.end();
+	}
+	
+	ConstIteratorType cend() const noexcept
+	{
+		return m_elements.cend();
+	}
+};
+
+#endif
@@ -0,0 +1,397 @@
+#ifndef SoAVector_HPP
+#define SoAVector_HPP
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+// Vector of records stored column by column: every field has its own contiguous buffer,
+// so a loop over one field only pulls that field through the cache.
+// Grows and shrinks exactly like Vector does.
+template<class... Fields>
+class SoAVector
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef std::tuple<Fields...> ElementType;
+	
+	static constexpr SizeType COLUMN_COUNT = sizeof...(Fields);
+	
+	template<SizeType Column>
+	using ColumnType = std::tuple_element_t<Column, ElementType>;
+	
+private:
+	
+	typedef std::index_sequence_for<Fields...> ColumnIndices;
+	
+	class SoAVectorRow;
+	class SoAVectorIterator;
+	
+public:
+	
+	typedef SoAVectorRow RowType;
+	typedef SoAVectorIterator IteratorType;
+	
+private:
+	
+	SizeType m_capacity, m_length;
+	std::tuple<Fields *...> m_columns;
+	
+public:
+	
+	SoAVector(SizeType initial_capacity = 1)
+		: m_capacity(initial_capacity), m_length(0), m_columns(new Fields[initial_capacity]...)
+	{}
+	
+	SoAVector(const SoAVector &other)
+		: m_capacity(other.m_capacity), m_length(other.m_length), m_columns(new Fields[other.m_capacity]...)
+	{
+		copy_columns(other, ColumnIndices());
+	}
+	
+	SoAVector(SoAVector &&other) noexcept
+		: m_capacity(other.m_capacity), m_length(other.m_length), m_columns(other.m_columns)
+	{
+		other.m_capacity = 0;
+		other.m_length = 0;
+		other.m_columns = std::tuple<Fields *...>(static_cast<Fields *>(nullptr)...);
+	}
+	
+	~SoAVector()
+	{
+		delete_columns(m_columns, ColumnIndices());
+	}
+	
+	SoAVector &operator=(SoAVector other) noexcept
+	{
+		std::swap(m_capacity, other.m_capacity);
+		std::swap(m_length, other.m_length);
+		std::swap(m_columns, other.m_columns);
+		return *this;
+	}
+	
+private:
+	
+	void expand_if_needed()
+	{
+		if(m_length == m_capacity)
+		{
+			resize(m_capacity == 0 ? 1 : m_capacity * 2);
+		}
+	}
+	
+	void contract_if_needed()
+	{
+		if(m_length < m_capacity / 2)
+		{
+			resize(m_capacity / 2);
+		}
+	}
+	
+	template<SizeType... Columns>
+	void copy_columns(const SoAVector &other, std::index_sequence<Columns...>)
+	{
+		(copy_column(std::get<Columns>(m_columns), std::get<Columns>(other.m_columns), m_length), ...);
+	}
+	
+	template<class T>
+	static void copy_column(T *destination, const T *source, SizeType length)
+	{
+		for(SizeType i = 0; i < length; ++i)
+		{
+			destination[i] = source[i];
+		}
+	}
+	
+	template<SizeType... Columns>
+	static void delete_columns(std::tuple<Fields *...> &columns, std::index_sequence<Columns...>)
+	{
+		(delete[] std::get<Columns>(columns), ...);
+	}
+	
+	template<SizeType... Columns>
+	void resize_columns(SizeType new_capacity, SizeType new_length, std::index_sequence<Columns...>)
+	{
+		(resize_column(std::get<Columns>(m_columns), new_capacity, new_length), ...);
+	}
+	
+	template<class T>
+	static void resize_column(T *&column, SizeType new_capacity, SizeType new_length)
+	{
+		T *new_column = new T[new_capacity];
+		for(SizeType i = 0; i < new_length; ++i)
+		{
+			new_column[i] = std::move(column[i]);
+		}
+		delete[] column;
+		column = new_column;
+	}
+	
+	template<SizeType... Columns>
+	void move_row(SizeType destination, SizeType source, std::index_sequence<Columns...>)
+	{
+		((std::get<Columns>(m_columns)[destination] = std::move(std::get<Columns>(m_columns)[source])), ...);
+	}
+	
+	template<SizeType... Columns>
+	void store_row(SizeType pos, const Fields &... values, std::index_sequence<Columns...>)
+	{
+		((std::get<Columns>(m_columns)[pos] = values), ...);
+	}
+	
+public:
+	
+	void resize(SizeType new_capacity)
+	{
+		SizeType new_length = m_length < new_capacity ? m_length : new_capacity;
+		resize_columns(new_capacity, new_length, ColumnIndices());
+		m_capacity = new_capacity;
+		m_length = new_length;
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	SizeType capacity() const noexcept
+	{
+		return m_capacity;
+	}
+	
+	void clear()
+	{
+		resize(0);
+	}
+	
+	void add_back(const Fields &... values)
+	{
+		expand_if_needed();
+		store_row(m_length++, values..., ColumnIndices());
+		contract_if_needed();
+	}
+	
+	void add(SizeType pos, const Fields &... values)
+	{
+		if(pos > m_length)
+		{
+			throw std::out_of_range("");
+		}
+		expand_if_needed();
+		for(SizeType i = m_length; i > pos; --i)
+		{
+			move_row(i, i - 1, ColumnIndices());
+		}
+		store_row(pos, values..., ColumnIndices());
+		++m_length;
+		contract_if_needed();
+	}
+	
+	void remove_back()
+	{
+		if(m_length == 0)
+		{
+			throw std::out_of_range("");
+		}
+		--m_length;
+		contract_if_needed();
+		expand_if_needed();
+	}
+	
+	void remove(SizeType pos)
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		--m_length;
+		for(SizeType i = pos; i < m_length; ++i)
+		{
+			move_row(i, i + 1, ColumnIndices());
+		}
+		contract_if_needed();
+		expand_if_needed();
+	}
+	
+	void set(SizeType pos, const Fields &... values)
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		store_row(pos, values..., ColumnIndices());
+	}
+	
+	template<SizeType Column>
+	ColumnType<Column> &get(SizeType pos)
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		return std::get<Column>(m_columns)[pos];
+	}
+	
+	template<SizeType Column>
+	const ColumnType<Column> &get(SizeType pos) const
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		return std::get<Column>(m_columns)[pos];
+	}
+	
+	RowType row(SizeType pos)
+	{
+		if(pos >= m_length)
+		{
+			throw std::out_of_range("");
+		}
+		return SoAVectorRow(this, pos);
+	}
+	
+	// The whole column as one contiguous span, for loops that should vectorize.
+	template<SizeType Column>
+	std::span<ColumnType<Column>> column() noexcept
+	{
+		return std::span<ColumnType<Column>>(std::get<Column>(m_columns), m_length);
+	}
+	
+	template<SizeType Column>
+	std::span<const ColumnType<Column>> column() const noexcept
+	{
+		return std::span<const ColumnType<Column>>(std::get<Column>(m_columns), m_length);
+	}
+	
+	template<SizeType Column>
+	ColumnType<Column> *data() noexcept
+	{
+		return std::get<Column>(m_columns);
+	}
+	
+	template<SizeType Column>
+	const ColumnType<Column> *data() const noexcept
+	{
+		return std::get<Column>(m_columns);
+	}
+	
+	IteratorType begin() noexcept
+	{
+		return SoAVectorIterator(this, 0);
+	}
+	
+	IteratorType end() noexcept
+	{
+		return SoAVectorIterator(this, m_length);
+	}
+	
+private:
+	
+	// Proxy for one record; reads and writes go straight to the columns.
+	class SoAVectorRow
+	{
+		SoAVector *m_vector;
+		SizeType m_pos;
+		
+	public:
+		
+		SoAVectorRow(SoAVector *vector, SizeType pos)
+			: m_vector(vector), m_pos(pos)
+		{}
+		
+		template<SizeType Column>
+		ColumnType<Column> &get() const noexcept
+		{
+			return std::get<Column>(m_vector -> m_columns)[m_pos];
+		}
+		
+		SizeType position() const noexcept
+		{
+			return m_pos;
+		}
+		
+		operator ElementType() const
+		{
+			return load(ColumnIndices());
+		}
+		
+		const SoAVectorRow &operator=(const ElementType &element) const
+		{
+			store(element, ColumnIndices());
+			return *this;
+		}
+		
+	private:
+		
+		template<SizeType... Columns>
+		ElementType load(std::index_sequence<Columns...>) const
+		{
+			return ElementType(std::get<Columns>(m_vector -> m_columns)[m_pos]...);
+		}
+		
+		template<SizeType... Columns>
+		void store(const ElementType &element, std::index_sequence<Columns...>) const
+		{
+			((std::get<Columns>(m_vector -> m_columns)[m_pos] = std::get<Columns>(element)), ...);
+		}
+	};
+	
+	class SoAVectorIterator
+	{
+		SoAVector *m_vector;
+		SizeType m_pos;
+		
+	public:
+		
+		SoAVectorIterator(SoAVector *vector, SizeType pos)
+			: m_vector(vector), m_pos(pos)
+		{}
+		
+		SoAVectorRow operator*() const noexcept
+		{
+			return SoAVectorRow(m_vector, m_pos);
+		}
+		
+		bool operator==(const SoAVectorIterator &other) const noexcept
+		{
+			return m_pos == other.m_pos;
+		}
+		
+		bool operator!=(const SoAVectorIterator &other) const noexcept
+		{
+			return m_pos != other.m_pos;
+		}
+		
+		SoAVectorIterator operator++(int) noexcept
+		{
+			SoAVectorIterator unincremented(m_vector, m_pos);
+			++m_pos;
+			return unincremented;
+		}
+		
+		SoAVectorIterator &operator++() noexcept
+		{
+			++m_pos;
+			return *this;
+		}
+		
+		SoAVectorIterator operator--(int) noexcept
+		{
+			SoAVectorIterator undecremented(m_vector, m_pos);
+			--m_pos;
+			return undecremented;
+		}
+		
+		SoAVectorIterator &operator--() noexcept
+		{
+			--m_pos;
+			return *this;
+		}
+	};
+};
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef StringInterner_HPP
+#define StringInterner_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "HashTable.hpp"
+#include "Hashers.hpp"
+#include "Vector.hpp"
+
+// Stores every distinct string once and names it by a 32-bit id, handed out in order from 0, so
+// that equal strings get equal ids. The characters go into an append-only arena of large chunks
+// that never move, so the string_views handed out stay valid for the life of the interner.
+// A HashTable of (string, id) pairs finds existing strings; a Vector from id to string turns ids back.
+class StringInterner
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef std::uint32_t IdType;
+	
+	static constexpr SizeType CHUNK_BYTES = SizeType(1) << 16;
+	
+private:
+	
+	// strings longer than this get a chunk of their own instead of cutting the current one short
+	static constexpr SizeType LARGE_STRING_BYTES = CHUNK_BYTES / 4;
+	
+	typedef std::pair<std::string_view, IdType> EntryType;
+	
+	struct EntryKey
+	{
+		static std::string_view get(const EntryType &entry) noexcept
+		{
+			return entry.first;
+		}
+	};
+	
+	HashTable<std::string_view, EntryType, EntryKey, StringHasher> m_ids;
+	Vector<std::string_view> m_strings;
+	Vector<char *> m_chunks;
+	char *m_free;
+	SizeType m_free_bytes, m_arena_bytes;
+	
+public:
+	
+	StringInterner()
+		: m_ids(StringHasher(), 10, 0.75f), m_strings(), m_chunks(), m_free(nullptr), m_free_bytes(0), m_arena_bytes(0)
+	{}
+	
+	StringInterner(const StringInterner &) = delete;
+	
+	StringInterner(StringInterner &&other) noexcept
+		: StringInterner()
+	{
+		swap(other);
+	}
+	
+	~StringInterner()
+	{
+		for(char *chunk : m_chunks)
+		{
+			delete[] chunk;
+		}
+	}
+	
+	StringInterner &operator=(StringInterner other) noexcept
+	{
+		swap(other);
+		return *this;
+	}
+	
+	// The number of distinct strings.
+	SizeType count() const noexcept
+	{
+		return m_strings.count();
+	}
+	
+	// The bytes of all the chunks, used or not.
+	SizeType arena_bytes() const noexcept
+	{
+		return m_arena_bytes;
+	}
+	
+	bool contains(std::string_view string) const
+	{
+		return m_ids.find(string) != nullptr;
+	}
+	
+	// Gives the id of the string, copying the string into the arena when it is new.
+	IdType intern(std::string_view string)
+	{
+		const EntryType *entry = m_ids.find(string);
+		if(entry != nullptr)
+		{
+			return entry -> second;
+		}
+		if(m_strings.count() == ~IdType(0))
+		{
+			throw std::length_error("");
+		}
+		std::string_view stored = store(string);
+		IdType id = static_cast<IdType>(m_strings.count());
+		m_strings.add_back(stored);
+		m_ids.insert(EntryType(stored, id));
+		return id;
+	}
+	
+	// Throws when the string was never interned.
+	IdType get_id(std::string_view string) const
+	{
+		const EntryType *entry = m_ids.find(string);
+		if(entry == nullptr)
+		{
+			throw std::out_of_range("");
+		}
+		return entry -> second;
+	}
+	
+	std::string_view get(IdType id) const
+	{
+		return m_strings.get(id);
+	}
+	
+	void swap(StringInterner &other) noexcept
+	{
+		std::swap(m_ids, other.m_ids);
+		std::swap(m_strings, other.m_strings);
+		std::swap(m_chunks, other.m_chunks);
+		std::swap(m_free, other.m_free);
+		std::swap(m_free_bytes, other.m_free_bytes);
+		std::swap(m_arena_bytes, other.m_arena_bytes);
+	}
+	
+private:
+	
+	std::string_view store(std::string_view string)
+	{
+		if(string.size() == 0)
+		{
+			return std::string_view();
+		}
+		if(string.size() > LARGE_STRING_BYTES)
+		{
+			char *chunk = add_chunk(string.size());
+			std::memcpy(chunk, string.data(), string.size());
+			return std::string_view(chunk, string.size());
+		}
+		if(string.size() > m_free_bytes)
+		{
+			m_free = add_chunk(CHUNK_BYTES);
+			m_free_bytes = CHUNK_BYTES;
+		}
+		char *characters = m_free;
+		std::memcpy(characters, string.data(), string.size());
+		m_free += string.size();
+		m_free_bytes -= string.size();
+		return std::string_view(characters, string.size());
+	}
+	
+	char *add_chunk(SizeType bytes)
+	{
+		char *chunk = new char[bytes];
+		m_chunks.add_back(chunk);
+		m_arena_bytes += bytes;
+		return chunk;
+	}
+};
+
+#endif
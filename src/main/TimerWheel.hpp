@@ -0,0 +1,245 @@
+#ifndef TimerWheel_HPP
+#define TimerWheel_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+#include "Vector.hpp"
+
+// Hierarchical timing wheel. Level L has SLOTS slots of SLOTS^L ticks each; a timer sits on the level
+// of the highest SLOT_BITS-bit digit in which its expiry tick differs from the current tick. Each slot
+// is a LinkedList-style doubly linked list threaded by index through one pool of nodes, so scheduling
+// and cancelling are O(1), and a timer is moved down a level at most LEVELS - 1 times before it fires.
+template<class Payload>
+class TimerWheel
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef std::uint64_t TickType;
+	typedef Payload PayloadType;
+	
+	static constexpr SizeType SLOT_BITS = 6;
+	static constexpr SizeType SLOTS = SizeType(1) << SLOT_BITS;
+	static constexpr SizeType LEVELS = (64 + SLOT_BITS - 1) / SLOT_BITS;
+	
+	// Identifies one scheduled timer; it goes stale once the timer fires or is cancelled.
+	struct TimerHandle
+	{
+		std::uint32_t index, generation;
+	};
+	
+private:
+	
+	static constexpr std::uint32_t NONE = ~std::uint32_t(0);
+	
+	struct Node
+	{
+		PayloadType payload;
+		TickType expiry;
+		std::uint32_t prev, next, slot, generation;
+		bool scheduled;
+	};
+	
+	Vector<Node> m_nodes;
+	Vector<std::uint32_t> m_slots;
+	Vector<PayloadType> m_expired;
+	std::uint32_t m_free;
+	SizeType m_length;
+	TickType m_now;
+	
+public:
+	
+	TimerWheel(TickType start = 0)
+		: m_nodes(0),
+		m_slots(LEVELS * SLOTS, NONE),
+		m_expired(0),
+		m_free(NONE),
+		m_length(0),
+		m_now(start)
+	{}
+	
+	TickType now() const noexcept
+	{
+		return m_now;
+	}
+	
+	// The number of timers that have not fired or been cancelled yet.
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+	
+	// Fires once the wheel has advanced delay ticks; a delay of 0 counts as 1.
+	TimerHandle schedule(TickType delay, const PayloadType &payload)
+	{
+		std::uint32_t node = allocate_node();
+		Node &timer = m_nodes.get(node);
+		timer.payload = payload;
+		timer.expiry = m_now + (delay == 0 ? 1 : delay);
+		timer.scheduled = true;
+		place(node);
+		++m_length;
+		return TimerHandle{ .index = node, .generation = timer.generation };
+	}
+	
+	// Returns false when the timer has already fired or been cancelled.
+	bool cancel(TimerHandle handle)
+	{
+		if(handle.index >= m_nodes.count())
+		{
+			return false;
+		}
+		Node &timer = m_nodes.get(handle.index);
+		if(!timer.scheduled || timer.generation != handle.generation)
+		{
+			return false;
+		}
+		unlink(handle.index);
+		release_node(handle.index);
+		--m_length;
+		return true;
+	}
+	
+	// Moves the wheel forward tick by tick. Every tick that expires timers calls
+	// on_expired(std::span<PayloadType>) once with all of their payloads; the callback may
+	// schedule and cancel timers, but must not advance the wheel.
+	template<class OnExpired>
+	void advance(TickType ticks, OnExpired on_expired)
+	{
+		for(TickType tick = 0; tick < ticks; ++tick)
+		{
+			if(m_length == 0)
+			{
+				m_now += ticks - tick;
+				return;
+			}
+			++m_now;
+			for(SizeType level = 1; level < LEVELS; ++level)
+			{
+				if((m_now & ((TickType(1) << (level * SLOT_BITS)) - 1)) != 0)
+				{
+					break;
+				}
+				cascade(level * SLOTS + ((m_now >> (level * SLOT_BITS)) & (SLOTS - 1)));
+			}
+			fire(m_now & (SLOTS - 1), on_expired);
+		}
+	}
+	
+private:
+	
+	std::uint32_t allocate_node()
+	{
+		if(m_free != NONE)
+		{
+			std::uint32_t node = m_free;
+			m_free = m_nodes.get(node).next;
+			return node;
+		}
+		m_nodes.add_back(Node{ .payload = PayloadType(), .expiry = 0, .prev = NONE, .next = NONE, .slot = 0, .generation = 0, .scheduled = false });
+		return static_cast<std::uint32_t>(m_nodes.count() - 1);
+	}
+	
+	void release_node(std::uint32_t node)
+	{
+		Node &timer = m_nodes.get(node);
+		timer.scheduled = false;
+		++timer.generation;
+		timer.next = m_free;
+		m_free = node;
+	}
+	
+	void place(std::uint32_t node)
+	{
+		Node &timer = m_nodes.get(node);
+		TickType difference = timer.expiry ^ m_now;
+		SizeType level = difference == 0 ? 0 : (std::bit_width(difference) - 1) / SLOT_BITS;
+		std::uint32_t slot = static_cast<std::uint32_t>(level * SLOTS + ((timer.expiry >> (level * SLOT_BITS)) & (SLOTS - 1)));
+		timer.slot = slot;
+		timer.prev = NONE;
+		timer.next = m_slots.get(slot);
+		if(timer.next != NONE)
+		{
+			m_nodes.get(timer.next).prev = node;
+		}
+		m_slots.set(slot, node);
+	}
+	
+	void unlink(std::uint32_t node)
+	{
+		Node &timer = m_nodes.get(node);
+		if(timer.prev == NONE)
+		{
+			m_slots.set(timer.slot, timer.next);
+		}
+		else
+		{
+			m_nodes.get(timer.prev).next = timer.next;
+		}
+		if(timer.next != NONE)
+		{
+			m_nodes.get(timer.next).prev = timer.prev;
+		}
+	}
+	
+	// Detaches the whole slot list and returns its first node.
+	std::uint32_t take_slot(SizeType slot)
+	{
+		std::uint32_t first = m_slots.get(slot);
+		m_slots.set(slot, NONE);
+		return first;
+	}
+	
+	// Re-places the timers of a higher level slot whose time has come, now that they are closer.
+	void cascade(SizeType slot)
+	{
+		for(std::uint32_t node = take_slot(slot); node != NONE; )
+		{
+			std::uint32_t next = m_nodes.get(node).next;
+			place(node);
+			node = next;
+		}
+	}
+	
+	// The batch buffer only ever grows, so a warm wheel does not allocate while firing.
+	void grow_expired()
+	{
+		Vector<PayloadType> grown(m_expired.count() == 0 ? SLOTS : m_expired.count() * 2, PayloadType());
+		for(SizeType i = 0; i < m_expired.count(); ++i)
+		{
+			grown.set(i, m_expired.get(i));
+		}
+		m_expired = std::move(grown);
+	}
+	
+	template<class OnExpired>
+	void fire(SizeType slot, OnExpired &on_expired)
+	{
+		std::uint32_t first = take_slot(slot);
+		if(first == NONE)
+		{
+			return;
+		}
+		SizeType expired = 0;
+		for(std::uint32_t node = first; node != NONE; )
+		{
+			if(expired == m_expired.count())
+			{
+				grow_expired();
+			}
+			Node &timer = m_nodes.get(node);
+			std::uint32_t next = timer.next;
+			m_expired.set(expired++, timer.payload);
+			release_node(node);
+			node = next;
+		}
+		m_length -= expired;
+		on_expired(std::span<PayloadType>(m_expired.begin(), expired));
+	}
+};
+
+#endif
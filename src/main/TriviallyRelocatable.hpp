@@ -0,0 +1,19 @@
+#ifndef TriviallyRelocatable_HPP
+#define TriviallyRelocatable_HPP
+
+#include <type_traits>
+
+// Whether an Elem can be moved to another address by copying its bytes and forgetting the old
+// ones, without running its move constructor and destructor. True for trivially copyable types;
+// a type that owns memory through plain pointers and keeps no pointer into itself (unlike a string
+// with a small-string buffer) can opt in with
+//
+//     template<> struct IsTriviallyRelocatable<Handle> : std::true_type {};
+//
+// Vector storage grows buffers of such elements in place or with realloc and mremap, so the pages
+// of a large buffer are remapped rather than copied.
+template<class Elem>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<Elem>>
+{};
+
+#endif
@@ -2,16 +2,105 @@
 #define Vector_HPP
 
 #include <cstddef>
+#include <cstdlib>
+#include <new>
 #include <stdexcept>
 #include <initializer_list>
+#include <type_traits>
+#include <utility>
 
-template<class Elem>
+#include "TriviallyRelocatable.hpp"
+
+// Where a Vector gets its buffer from. The default is plain new[]/delete[], which keeps Vector usable
+// in constant expressions; see AlignedStorage.hpp for aligned and huge-page-backed buffers.
+// Outside constant evaluation, trivially relocatable elements are kept in malloc'd buffers instead,
+// so that growing one is a realloc, which the C library does by remapping pages for large blocks.
+// A storage that can move its buffers like that offers reallocate, which Vector::resize then uses.
+struct DefaultStorage
+{
+	// the elements past the old count are constructed after the buffer has moved, so that must not throw
+	template<class Elem>
+	static constexpr bool CAN_REALLOCATE = IsTriviallyRelocatable<Elem>::value && std::is_nothrow_default_constructible_v<Elem>
+		&& alignof(Elem) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+	
+	template<class Elem>
+	static constexpr Elem *allocate(std::size_t count)
+	{
+		if constexpr(CAN_REALLOCATE<Elem>)
+		{
+			if(!std::is_constant_evaluated())
+			{
+				return construct(static_cast<Elem *>(resize_block(nullptr, count * sizeof(Elem))), 0, count);
+			}
+		}
+		return new Elem[count];
+	}
+	
+	template<class Elem>
+	static constexpr void deallocate(Elem *buffer, std::size_t count)
+	{
+		if constexpr(CAN_REALLOCATE<Elem>)
+		{
+			if(!std::is_constant_evaluated())
+			{
+				destroy(buffer, 0, count);
+				std::free(buffer);
+				return;
+			}
+		}
+		delete[] buffer;
+	}
+	
+	// Moves the elements with their bytes; the ones past new_count are destroyed.
+	template<class Elem> requires CAN_REALLOCATE<Elem>
+	static Elem *reallocate(Elem *buffer, std::size_t old_count, std::size_t new_count)
+	{
+		destroy(buffer, new_count, old_count);
+		return construct(static_cast<Elem *>(resize_block(buffer, new_count * sizeof(Elem))), old_count, new_count);
+	}
+	
+private:
+	
+	static void *resize_block(void *block, std::size_t bytes)
+	{
+		// realloc to 0 bytes may free the block and return null
+		void *resized = std::realloc(block, bytes == 0 ? 1 : bytes);
+		if(resized == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		return resized;
+	}
+	
+	// Default-initializes the elements from .. to, as new[] does.
+	template<class Elem>
+	static Elem *construct(Elem *buffer, std::size_t from, std::size_t to) noexcept
+	{
+		for(std::size_t i = from; i < to; ++i)
+		{
+			new(buffer + i) Elem;
+		}
+		return buffer;
+	}
+	
+	template<class Elem>
+	static void destroy(Elem *buffer, std::size_t from, std::size_t to) noexcept
+	{
+		for(std::size_t i = from; i < to; ++i)
+		{
+			buffer[i].~Elem();
+		}
+	}
+};
+
+template<class Elem, class Storage = DefaultStorage>
 class Vector
 {
 public:
 	
 	typedef std::size_t SizeType;
 	typedef Elem ElementType;
+	typedef Storage StorageType;
 	
 private:
 	
@@ -32,11 +121,11 @@ private:
 	
 public:
 	
-	Vector(SizeType initial_capacity = 1)
-		: m_capacity(initial_capacity), m_length(0), m_buffer(new ElementType[initial_capacity])
+	constexpr Vector(SizeType initial_capacity = 1)
+		: m_capacity(initial_capacity), m_length(0), m_buffer(allocate(initial_capacity))
 	{}
 	
-	Vector(std::initializer_list<ElementType> elements)
+	constexpr Vector(std::initializer_list<ElementType> elements)
 		: Vector(elements.size())
 	{
 		for(const ElementType &value : elements)
@@ -45,22 +134,69 @@ public:
 		}
 	}
 	
-	~Vector()
+	constexpr Vector(SizeType count, const ElementType &value)
+		: m_capacity(count), m_length(count), m_buffer(allocate(count))
+	{
+		for(SizeType i = 0; i < count; ++i)
+		{
+			m_buffer[i] = value;
+		}
+	}
+	
+	constexpr Vector(const Vector &other)
+		: m_capacity(other.m_capacity), m_length(other.m_length), m_buffer(allocate(other.m_capacity))
+	{
+		for(SizeType i = 0; i < m_length; ++i)
+		{
+			m_buffer[i] = other.m_buffer[i];
+		}
+	}
+	
+	constexpr Vector(Vector &&other) noexcept
+		: m_capacity(other.m_capacity), m_length(other.m_length), m_buffer(other.m_buffer)
+	{
+		other.m_capacity = 0;
+		other.m_length = 0;
+		other.m_buffer = nullptr;
+	}
+	
+	constexpr ~Vector()
+	{
+		deallocate(m_buffer, m_capacity);
+	}
+	
+	constexpr Vector &operator=(Vector other) noexcept
 	{
-		delete[] m_buffer;
+		std::swap(m_capacity, other.m_capacity);
+		std::swap(m_length, other.m_length);
+		std::swap(m_buffer, other.m_buffer);
+		return *this;
 	}
 	
 private:
 	
-	void expand_if_needed()
+	static constexpr ElementType *allocate(SizeType capacity)
+	{
+		return StorageType::template allocate<ElementType>(capacity);
+	}
+	
+	static constexpr void deallocate(ElementType *buffer, SizeType capacity)
+	{
+		if(buffer != nullptr)
+		{
+			StorageType::template deallocate<ElementType>(buffer, capacity);
+		}
+	}
+	
+	constexpr void expand_if_needed()
 	{
 		if(m_length == m_capacity)
 		{
-			resize(m_capacity * 2);
+			resize(m_capacity == 0 ? 1 : m_capacity * 2);
 		}
 	}
 	
-	void contract_if_needed()
+	constexpr void contract_if_needed()
 	{
 		if(m_length < m_capacity / 2)
 		{
@@ -70,48 +206,59 @@ private:
 	
 public:
 	
-	void resize(SizeType new_capacity)
+	constexpr void resize(SizeType new_capacity)
 	{
-		ElementType *new_buffer = new ElementType[new_capacity];
+		if constexpr(requires(ElementType *buffer, SizeType count) { StorageType::template reallocate<ElementType>(buffer, count, count); })
+		{
+			// the storage moves the buffer as a whole, so the elements are not moved one by one
+			if(!std::is_constant_evaluated() && m_buffer != nullptr)
+			{
+				m_buffer = StorageType::template reallocate<ElementType>(m_buffer, m_capacity, new_capacity);
+				m_capacity = new_capacity;
+				m_length = m_length < new_capacity ? m_length : new_capacity;
+				return;
+			}
+		}
+		ElementType *new_buffer = allocate(new_capacity);
 		SizeType new_length = m_length < new_capacity ? m_length : new_capacity;
 		for(SizeType i = 0; i < new_length; ++i)
 		{
-			new_buffer[i] = m_buffer[i];
+			new_buffer[i] = std::move(m_buffer[i]);
 		}
+		deallocate(m_buffer, m_capacity);
 		m_capacity = new_capacity;
 		m_length = new_length;
-		delete[] m_buffer;
 		m_buffer = new_buffer;
 	}
 	
-	SizeType count() const noexcept
+	constexpr SizeType count() const noexcept
 	{
 		return m_length;
 	}
 	
-	SizeType capacity() const noexcept
+	constexpr SizeType capacity() const noexcept
 	{
 		return m_capacity;
 	}
 	
-	void clear()
+	constexpr void clear()
 	{
 		resize(0);
 	}
 	
-	void add_back(const ElementType &value)
+	constexpr void add_back(const ElementType &value)
 	{
 		expand_if_needed();
 		m_buffer[m_length++] = value;
 		contract_if_needed();
 	}
 	
-	void add_front(const ElementType &value)
+	constexpr void add_front(const ElementType &value)
 	{
 		add(0, value);
 	}
 	
-	void add(SizeType pos, const ElementType &value)
+	constexpr void add(SizeType pos, const ElementType &value)
 	{
 		if(pos > m_length)
 		{
@@ -128,7 +275,7 @@ public:
 		contract_if_needed();
 	}
 	
-	ElementType &get_back()
+	constexpr ElementType &get_back()
 	{
 		if(m_length == 0)
 		{
@@ -137,7 +284,7 @@ public:
 		return m_buffer[m_length - 1];
 	}
 	
-	const ElementType &get_back() const
+	constexpr const ElementType &get_back() const
 	{
 		if(m_length == 0)
 		{
@@ -146,7 +293,7 @@ public:
 		return m_buffer[m_length - 1];
 	}
 	
-	ElementType &get_front()
+	constexpr ElementType &get_front()
 	{
 		if(m_length == 0)
 		{
@@ -155,7 +302,7 @@ public:
 		return m_buffer[0];
 	}
 	
-	const ElementType &get_front() const
+	constexpr const ElementType &get_front() const
 	{
 		if(m_length == 0)
 		{
@@ -164,7 +311,7 @@ public:
 		return m_buffer[0];
 	}
 	
-	ElementType &get(SizeType pos)
+	constexpr ElementType &get(SizeType pos)
 	{
 		if(pos >= m_length)
 		{
@@ -173,7 +320,7 @@ public:
 		return m_buffer[pos];
 	}
 	
-	const ElementType &get(SizeType pos) const
+	constexpr const ElementType &get(SizeType pos) const
 	{
 		if(pos >= m_length)
 		{
@@ -182,7 +329,7 @@ public:
 		return m_buffer[pos];
 	}
 	
-	void remove_back()
+	constexpr void remove_back()
 	{
 		if(m_length == 0)
 		{
@@ -193,12 +340,12 @@ public:
 		expand_if_needed();
 	}
 	
-	void remove_front()
+	constexpr void remove_front()
 	{
 		remove(0);
 	}
 	
-	void remove(SizeType pos)
+	constexpr void remove(SizeType pos)
 	{
 		if(pos >= m_length)
 		{
@@ -213,7 +360,7 @@ public:
 		expand_if_needed();
 	}
 	
-	void set_back(const ElementType &value)
+	constexpr void set_back(const ElementType &value)
 	{
 		if(m_length == 0)
 		{
@@ -222,7 +369,7 @@ public:
 		m_buffer[m_length - 1] = value;
 	}
 	
-	void set_front(const ElementType &value)
+	constexpr void set_front(const ElementType &value)
 	{
 		if(m_length == 0)
 		{
@@ -231,7 +378,7 @@ public:
 		m_buffer[0] = value;
 	}
 	
-	void set(SizeType pos, const ElementType &value)
+	constexpr void set(SizeType pos, const ElementType &value)
 	{
 		if(pos >= m_length)
 		{
@@ -240,42 +387,42 @@ public:
 		m_buffer[pos] = value;
 	}
 	
-	IteratorType begin() noexcept
+	constexpr IteratorType begin() noexcept
 	{
 		return m_buffer;
 	}
 	
-	ConstIteratorType cbegin() const noexcept
+	constexpr ConstIteratorType cbegin() const noexcept
 	{
 		return m_buffer;
 	}
 	
-	ReverseIteratorType rbegin() noexcept
+	constexpr ReverseIteratorType rbegin() noexcept
 	{
 		return VectorReverseIterator(m_buffer + m_length - 1);
 	}
 	
-	ConstReverseIteratorType crbegin() const noexcept
+	constexpr ConstReverseIteratorType crbegin() const noexcept
 	{
 		return VectorConstReverseIterator(m_buffer + m_length - 1);
 	}
 	
-	IteratorType end() noexcept
+	constexpr IteratorType end() noexcept
 	{
 		return m_buffer + m_length;
 	}
 	
-	ConstIteratorType cend() const noexcept
+	constexpr ConstIteratorType cend() const noexcept
 	{
 		return m_buffer + m_length;
 	}
 	
-	ReverseIteratorType rend() noexcept
+	constexpr ReverseIteratorType rend() noexcept
 	{
 		return VectorReverseIterator(m_buffer - 1);
 	}
 	
-	ConstReverseIteratorType crend() const noexcept
+	constexpr ConstReverseIteratorType crend() const noexcept
 	{
 		return VectorConstReverseIterator(m_buffer - 1);
 	}
@@ -288,51 +435,51 @@ private:
 		
 	public:
 		
-		VectorReverseIterator(ElementType *ptr)
+		constexpr VectorReverseIterator(ElementType *ptr)
 			: m_ptr(ptr)
 		{}
 		
-		const ElementType &operator*() const
+		constexpr const ElementType &operator*() const
 		{
 			return *m_ptr;
 		}
 		
-		ElementType &operator*()
+		constexpr ElementType &operator*()
 		{
 			return *m_ptr;
 		}
 		
-		bool operator==(const VectorReverseIterator &other) const noexcept
+		constexpr bool operator==(const VectorReverseIterator &other) const noexcept
 		{
 			return m_ptr == other.m_ptr;
 		}
 		
-		bool operator!=(const VectorReverseIterator &other) const noexcept
+		constexpr bool operator!=(const VectorReverseIterator &other) const noexcept
 		{
 			return m_ptr != other.m_ptr;
 		}
 		
-		VectorReverseIterator operator++(int) noexcept
+		constexpr VectorReverseIterator operator++(int) noexcept
 		{
 			VectorReverseIterator unincremented(m_ptr);
 			--m_ptr;
 			return unincremented;
 		}
 		
-		const VectorReverseIterator &operator++() noexcept
+		constexpr const VectorReverseIterator &operator++() noexcept
 		{
 			--m_ptr;
 			return *this;
 		}
 		
-		VectorReverseIterator operator--(int) noexcept
+		constexpr VectorReverseIterator operator--(int) noexcept
 		{
 			VectorReverseIterator undecremented(m_ptr);
 			++m_ptr;
 			return undecremented;
 		}
 		
-		const VectorReverseIterator &operator--() noexcept
+		constexpr const VectorReverseIterator &operator--() noexcept
 		{
 			++m_ptr;
 			return *this;
@@ -345,46 +492,46 @@ private:
 		
 	public:
 		
-		VectorConstReverseIterator(ElementType *ptr)
+		constexpr VectorConstReverseIterator(ElementType *ptr)
 			: m_ptr(ptr)
 		{}
 		
-		const ElementType &operator*() const
+		constexpr const ElementType &operator*() const
 		{
 			return *m_ptr;
 		}
 		
-		bool operator==(const VectorConstReverseIterator &other) const noexcept
+		constexpr bool operator==(const VectorConstReverseIterator &other) const noexcept
 		{
 			return m_ptr == other.m_ptr;
 		}
 		
-		bool operator!=(const VectorConstReverseIterator &other) const noexcept
+		constexpr bool operator!=(const VectorConstReverseIterator &other) const noexcept
 		{
 			return m_ptr != other.m_ptr;
 		}
 		
-		VectorConstReverseIterator operator++(int) noexcept
+		constexpr VectorConstReverseIterator operator++(int) noexcept
 		{
 			VectorConstReverseIterator unincremented(m_ptr);
 			--m_ptr;
 			return unincremented;
 		}
 		
-		const VectorConstReverseIterator &operator++() noexcept
+		constexpr const VectorConstReverseIterator &operator++() noexcept
 		{
 			--m_ptr;
 			return *this;
 		}
 		
-		VectorConstReverseIterator operator--(int) noexcept
+		constexpr VectorConstReverseIterator operator--(int) noexcept
 		{
 			VectorConstReverseIterator undecremented(m_ptr);
 			++m_ptr;
 			return undecremented;
 		}
 		
-		const VectorConstReverseIterator &operator--() noexcept
+		constexpr const VectorConstReverseIterator &operator--() noexcept
 		{
 			++m_ptr;
 			return *this;
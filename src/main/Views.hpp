@@ -0,0 +1,737 @@
+#ifndef Views_HPP
+#define Views_HPP
+
+#include <cstddef>
+#include <utility>
+
+#include "HashMap.hpp"
+#include "LinkedList.hpp"
+#include "Vector.hpp"
+
+// Lazy views over container iterators. Every step wraps the one before it, so a chain like
+//
+//     view(numbers).filter(is_even).transform(square).take(10).collect_into(squares);
+//
+// makes a single pass over numbers without any intermediate Vector. Views borrow the container
+// and hold their functions by value, so the container has to outlive the view.
+//
+// Views walk with cursors rather than begin/end iterator pairs: a cursor knows whether it still
+// points at an element (valid), returns the element (get) and steps to the next one (next).
+// Range-for works on every view through begin() and end().
+template<class Derived>
+class View;
+
+template<class Iterator>
+class IteratorView;
+
+template<class Inner, class Pred>
+class FilterView;
+
+template<class Inner, class Func>
+class TransformView;
+
+template<class Inner>
+class TakeView;
+
+template<class Inner>
+class DropView;
+
+template<class First, class Second>
+class ZipView;
+
+template<class Inner>
+class ChunkView;
+
+template<class Inner>
+class EnumerateView;
+
+template<class Cursor>
+class CursorView;
+
+namespace views_detail
+{
+	struct ViewEnd
+	{};
+	
+	// Adapts a cursor to range-for.
+	template<class Cursor>
+	class ViewIterator
+	{
+		Cursor m_cursor;
+		
+	public:
+		
+		explicit ViewIterator(const Cursor &cursor)
+			: m_cursor(cursor)
+		{}
+		
+		decltype(auto) operator*()
+		{
+			return m_cursor.get();
+		}
+		
+		bool operator!=(ViewEnd) const
+		{
+			return m_cursor.valid();
+		}
+		
+		ViewIterator &operator++()
+		{
+			m_cursor.next();
+			return *this;
+		}
+	};
+}
+
+// The operations shared by all views. Derived provides a CursorType, cursor(), SIZED and,
+// when SIZED is true, count().
+template<class Derived>
+class View
+{
+public:
+	
+	typedef std::size_t SizeType;
+	
+	template<class Pred>
+	FilterView<Derived, Pred> filter(Pred pred) const
+	{
+		return FilterView<Derived, Pred>(derived(), pred);
+	}
+	
+	template<class Func>
+	TransformView<Derived, Func> transform(Func func) const
+	{
+		return TransformView<Derived, Func>(derived(), func);
+	}
+	
+	TakeView<Derived> take(SizeType count) const
+	{
+		return TakeView<Derived>(derived(), count);
+	}
+	
+	DropView<Derived> drop(SizeType count) const
+	{
+		return DropView<Derived>(derived(), count);
+	}
+	
+	// Pairs of elements from both views, as long as the shorter one.
+	template<class Other>
+	ZipView<Derived, Other> zip(const Other &other) const
+	{
+		return ZipView<Derived, Other>(derived(), other);
+	}
+	
+	// Consecutive views of chunk_size elements each; the last one may be shorter.
+	ChunkView<Derived> chunk(SizeType chunk_size) const
+	{
+		return ChunkView<Derived>(derived(), chunk_size);
+	}
+	
+	// Pairs of each element's position and the element.
+	EnumerateView<Derived> enumerate() const
+	{
+		return EnumerateView<Derived>(derived());
+	}
+	
+	auto begin() const
+	{
+		return views_detail::ViewIterator<typename Derived::CursorType>(derived().cursor());
+	}
+	
+	views_detail::ViewEnd end() const noexcept
+	{
+		return views_detail::ViewEnd();
+	}
+	
+	// Appends every element to the vector. When the length of the view is known up front,
+	// the vector is grown with a single allocation.
+	template<class Elem, class Storage>
+	void collect_into(Vector<Elem, Storage> &vec) const
+	{
+		typename Derived::CursorType cursor = derived().cursor();
+		if constexpr(Derived::SIZED)
+		{
+			SizeType old_length = vec.count();
+			Vector<Elem, Storage> grown(old_length + derived().count(), Elem());
+			Elem *out = grown.begin();
+			for(SizeType i = 0; i < old_length; ++i)
+			{
+				*out++ = std::move(vec.get(i));
+			}
+			for(; cursor.valid(); cursor.next())
+			{
+				*out++ = cursor.get();
+			}
+			vec = std::move(grown);
+		}
+		else
+		{
+			for(; cursor.valid(); cursor.next())
+			{
+				vec.add_back(cursor.get());
+			}
+		}
+	}
+	
+private:
+	
+	const Derived &derived() const noexcept
+	{
+		return static_cast<const Derived &>(*this);
+	}
+};
+
+// The elements between two iterators of a container.
+template<class Iterator>
+class IteratorView : public View<IteratorView<Iterator>>
+{
+public:
+	
+	typedef std::size_t SizeType;
+	
+	static constexpr bool SIZED = true;
+	
+	class CursorType
+	{
+		Iterator m_iterator, m_end;
+		
+	public:
+		
+		CursorType()
+			: m_iterator(), m_end()
+		{}
+		
+		CursorType(const Iterator &iterator, const Iterator &end)
+			: m_iterator(iterator), m_end(end)
+		{}
+		
+		bool valid() const
+		{
+			return m_iterator != m_end;
+		}
+		
+		decltype(auto) get()
+		{
+			return *m_iterator;
+		}
+		
+		void next()
+		{
+			++m_iterator;
+		}
+	};
+	
+private:
+	
+	Iterator m_begin, m_end;
+	SizeType m_length;
+	
+public:
+	
+	IteratorView(const Iterator &begin, const Iterator &end, SizeType length)
+		: m_begin(begin), m_end(end), m_length(length)
+	{}
+	
+	CursorType cursor() const
+	{
+		return CursorType(m_begin, m_end);
+	}
+	
+	SizeType count() const noexcept
+	{
+		return m_length;
+	}
+};
+
+template<class Inner, class Pred>
+class FilterView : public View<FilterView<Inner, Pred>>
+{
+public:
+	
+	static constexpr bool SIZED = false;
+	
+	class CursorType
+	{
+		typename Inner::CursorType m_inner;
+		const Pred *m_pred;
+		
+	public:
+		
+		CursorType()
+			: m_inner(), m_pred(nullptr)
+		{}
+		
+		CursorType(const typename Inner::CursorType &inner, const Pred *pred)
+			: m_inner(inner), m_pred(pred)
+		{
+			skip_rejected();
+		}
+		
+		bool valid() const
+		{
+			return m_inner.valid();
+		}
+		
+		decltype(auto) get()
+		{
+			return m_inner.get();
+		}
+		
+		void next()
+		{
+			m_inner.next();
+			skip_rejected();
+		}
+		
+	private:
+		
+		void skip_rejected()
+		{
+			while(m_inner.valid() && !(*m_pred)(m_inner.get()))
+			{
+				m_inner.next();
+			}
+		}
+	};
+	
+private:
+	
+	Inner m_inner;
+	Pred m_pred;
+	
+public:
+	
+	FilterView(const Inner &inner, const Pred &pred)
+		: m_inner(inner), m_pred(pred)
+	{}
+	
+	CursorType cursor() const
+	{
+		return CursorType(m_inner.cursor(), &m_pred);
+	}
+};
+
+template<class Inner, class Func>
+class TransformView : public View<TransformView<Inner, Func>>
+{
+public:
+	
+	typedef std::size_t SizeType;
+	
+	static constexpr bool SIZED = Inner::SIZED;
+	
+	class CursorType
+	{
+		typename Inner::CursorType m_inner;
+		const Func *m_func;
+		
+	public:
+		
+		CursorType()
+			: m_inner(), m_func(nullptr)
+		{}
+		
+		CursorType(const typename Inner::CursorType &inner, const Func *func)
+			: m_inner(inner), m_func(func)
+		{}
+		
+		bool valid() const
+		{
+			return m_inner.valid();
+		}
+		
+		decltype(auto) get()
+		{
+			return (*m_func)(m_inner.get());
+		}
+		
+		void next()
+		{
+			m_inner.next();
+		}
+	};
+	
+private:
+	
+	Inner m_inner;
+	Func m_func;
+	
+public:
+	
+	TransformView(const Inner &inner, const Func &func)
+		: m_inner(inner), m_func(func)
+	{}
+	
+	CursorType cursor() const
+	{
+		return CursorType(m_inner.cursor(), &m_func);
+	}
+	
+	SizeType count() const
+	{
+		return m_inner.count();
+	}
+};
+
+template<class Inner>
+class TakeView : public View<TakeView<Inner>>
+{
+public:
+	
+	typedef std::size_t SizeType;
+	
+	static constexpr bool SIZED = Inner::SIZED;
+	
+	class CursorType
+	{
+		typename Inner::CursorType m_inner;
+		SizeType m_remaining;
+		
+	public:
+		
+		CursorType()
+			: m_inner(), m_remaining(0)
+		{}
+		
+		CursorType(const typename Inner::CursorType &inner, SizeType remaining)
+			: m_inner(inner), m_remaining(remaining)
+		{}
+		
+		bool valid() const
+		{
+			return m_remaining > 0 && m_inner.valid();
+		}
+		
+		decltype(auto) get()
+		{
+			return m_inner.get();
+		}
+		
+		void next()
+		{
+			--m_remaining;
+			// stepping the inner cursor past the last taken element could run a filter needlessly
+			if(m_remaining > 0)
+			{
+				m_inner.next();
+			}
+		}
+	};
+	
+private:
+	
+	Inner m_inner;
+	SizeType m_count;
+	
+public:
+	
+	// An empty view, so that chunks can be stored in a Vector.
+	TakeView()
+		: m_inner(), m_count(0)
+	{}
+	
+	TakeView(const Inner &inner, SizeType count)
+		: m_inner(inner), m_count(count)
+	{}
+	
+	CursorType cursor() const
+	{
+		return CursorType(m_inner.cursor(), m_count);
+	}
+	
+	SizeType count() const
+	{
+		return m_inner.count() < m_count ? m_inner.count() : m_count;
+	}
+};
+
+template<class Inner>
+class DropView : public View<DropView<Inner>>
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef typename Inner::CursorType CursorType;
+	
+	static constexpr bool SIZED = Inner::SIZED;
+	
+private:
+	
+	Inner m_inner;
+	SizeType m_count;
+	
+public:
+	
+	DropView(const Inner &inner, SizeType count)
+		: m_inner(inner), m_count(count)
+	{}
+	
+	CursorType cursor() const
+	{
+		CursorType cursor = m_inner.cursor();
+		for(SizeType i = 0; i < m_count && cursor.valid(); ++i)
+		{
+			cursor.next();
+		}
+		return cursor;
+	}
+	
+	SizeType count() const
+	{
+		return m_inner.count() > m_count ? m_inner.count() - m_count : 0;
+	}
+};
+
+template<class First, class Second>
+class ZipView : public View<ZipView<First, Second>>
+{
+public:
+	
+	typedef std::size_t SizeType;
+	
+	static constexpr bool SIZED = First::SIZED && Second::SIZED;
+	
+	class CursorType
+	{
+		typename First::CursorType m_first;
+		typename Second::CursorType m_second;
+		
+	public:
+		
+		CursorType()
+			: m_first(), m_second()
+		{}
+		
+		CursorType(const typename First::CursorType &first, const typename Second::CursorType &second)
+			: m_first(first), m_second(second)
+		{}
+		
+		bool valid() const
+		{
+			return m_first.valid() && m_second.valid();
+		}
+		
+		auto get()
+		{
+			return std::pair<decltype(m_first.get()), decltype(m_second.get())>(m_first.get(), m_second.get());
+		}
+		
+		void next()
+		{
+			m_first.next();
+			m_second.next();
+		}
+	};
+	
+private:
+	
+	First m_first;
+	Second m_second;
+	
+public:
+	
+	ZipView(const First &first, const Second &second)
+		: m_first(first), m_second(second)
+	{}
+	
+	CursorType cursor() const
+	{
+		return CursorType(m_first.cursor(), m_second.cursor());
+	}
+	
+	SizeType count() const
+	{
+		return m_first.count() < m_second.count() ? m_first.count() : m_second.count();
+	}
+};
+
+// A view that starts wherever a cursor currently is; chunks are made of these. Cursors are
+// default constructible, as are chunks, when the iterators underneath them are.
+template<class Cursor>
+class CursorView : public View<CursorView<Cursor>>
+{
+public:
+	
+	typedef Cursor CursorType;
+	
+	static constexpr bool SIZED = false;
+	
+private:
+	
+	Cursor m_cursor;
+	
+public:
+	
+	CursorView()
+		: m_cursor()
+	{}
+	
+	explicit CursorView(const Cursor &cursor)
+		: m_cursor(cursor)
+	{}
+	
+	CursorType cursor() const
+	{
+		return m_cursor;
+	}
+};
+
+template<class Inner>
+class ChunkView : public View<ChunkView<Inner>>
+{
+public:
+	
+	typedef std::size_t SizeType;
+	typedef TakeView<CursorView<typename Inner::CursorType>> ChunkType;
+	
+	static constexpr bool SIZED = Inner::SIZED;
+	
+	class CursorType
+	{
+		typename Inner::CursorType m_inner;
+		SizeType m_chunk_size;
+		
+	public:
+		
+		CursorType()
+			: m_inner(), m_chunk_size(1)
+		{}
+		
+		CursorType(const typename Inner::CursorType &inner, SizeType chunk_size)
+			: m_inner(inner), m_chunk_size(chunk_size)
+		{}
+		
+		bool valid() const
+		{
+			return m_inner.valid();
+		}
+		
+		ChunkType get()
+		{
+			return ChunkType(CursorView<typename Inner::CursorType>(m_inner), m_chunk_size);
+		}
+		
+		void next()
+		{
+			for(SizeType i = 0; i < m_chunk_size && m_inner.valid(); ++i)
+			{
+				m_inner.next();
+			}
+		}
+	};
+	
+private:
+	
+	Inner m_inner;
+	SizeType m_chunk_size;
+	
+public:
+	
+	ChunkView(const Inner &inner, SizeType chunk_size)
+		: m_inner(inner), m_chunk_size(chunk_size == 0 ? 1 : chunk_size)
+	{}
+	
+	CursorType cursor() const
+	{
+		return CursorType(m_inner.cursor(), m_chunk_size);
+	}
+	
+	SizeType count() const
+	{
+		return (m_inner.count() + m_chunk_size - 1) / m_chunk_size;
+	}
+};
+
+template<class Inner>
+class EnumerateView : public View<EnumerateView<Inner>>
+{
+public:
+	
+	typedef std::size_t SizeType;
+	
+	static constexpr bool SIZED = Inner::SIZED;
+	
+	class CursorType
+	{
+		typename Inner::CursorType m_inner;
+		SizeType m_pos;
+		
+	public:
+		
+		CursorType()
+			: m_inner(), m_pos(0)
+		{}
+		
+		explicit CursorType(const typename Inner::CursorType &inner)
+			: m_inner(inner), m_pos(0)
+		{}
+		
+		bool valid() const
+		{
+			return m_inner.valid();
+		}
+		
+		auto get()
+		{
+			return std::pair<SizeType, decltype(m_inner.get())>(m_pos, m_inner.get());
+		}
+		
+		void next()
+		{
+			m_inner.next();
+			++m_pos;
+		}
+	};
+	
+private:
+	
+	Inner m_inner;
+	
+public:
+	
+	explicit EnumerateView(const Inner &inner)
+		: m_inner(inner)
+	{}
+	
+	CursorType cursor() const
+	{
+		return CursorType(m_inner.cursor());
+	}
+	
+	SizeType count() const
+	{
+		return m_inner.count();
+	}
+};
+
+template<class Elem, class Storage>
+IteratorView<Elem *> view(Vector<Elem, Storage> &vec)
+{
+	return IteratorView<Elem *>(vec.begin(), vec.end(), vec.count());
+}
+
+template<class Elem, class Storage>
+IteratorView<const Elem *> view(const Vector<Elem, Storage> &vec)
+{
+	return IteratorView<const Elem *>(vec.cbegin(), vec.cend(), vec.count());
+}
+
+template<class Elem>
+IteratorView<typename LinkedList<Elem>::IteratorType> view(LinkedList<Elem> &list)
+{
+	return IteratorView<typename LinkedList<Elem>::IteratorType>(list.begin(), list.end(), list.count());
+}
+
+template<class Key, class Value, class HashFunc>
+IteratorView<typename HashMap<Key, Value, HashFunc>::IteratorType> view(HashMap<Key, Value, HashFunc> &map)
+{
+	return IteratorView<typename HashMap<Key, Value, HashFunc>::IteratorType>(map.begin(), map.end(), map.count());
+}
+
+template<class Key, class Value, class HashFunc>
+IteratorView<typename HashMap<Key, Value, HashFunc>::ConstIteratorType> view(const HashMap<Key, Value, HashFunc> &map)
+{
+	return IteratorView<typename HashMap<Key, Value, HashFunc>::ConstIteratorType>(map.cbegin(), map.cend(), map.count());
+}
+
+#endif
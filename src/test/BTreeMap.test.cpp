@@ -0,0 +1,211 @@
+#include "assert.hpp"
+#include "BTreeMap.hpp"
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <utility>
+
+void get_when_empty()
+{
+	BTreeMap<int, int> map;
+	
+	// expect to throw when looking up anything in an empty map
+	ASSERT(map.count() == 0)
+	ASSERT_FALSE(map.contains(0))
+	ASSERT_THROWS(map.get(0), std::out_of_range)
+	ASSERT_THROWS(map.remove(0), std::out_of_range)
+	ASSERT(map.begin() == map.end())
+	ASSERT(map.lower_bound(0) == map.end())
+}
+
+void set_get_remove()
+{
+	BTreeMap<int, std::string> map;
+	
+	ASSERT_NOTHROW(map.set(2, "two"))
+	ASSERT_NOTHROW(map.set(1, "one"))
+	ASSERT_NOTHROW(map.set(3, "three"))
+	ASSERT_NOTHROW(map.set(2, "TWO"))
+	ASSERT(map.count() == 3)
+	ASSERT(map.get(1) == "one")
+	ASSERT(map.get(2) == "TWO")
+	ASSERT(map.get(3) == "three")
+	ASSERT_THROWS(map.get(4), std::out_of_range)
+	
+	ASSERT_NOTHROW(map.remove(2))
+	ASSERT(map.count() == 2)
+	ASSERT_FALSE(map.contains(2))
+	ASSERT_THROWS(map.remove(2), std::out_of_range)
+}
+
+// random inserts and removes big enough to split and merge several levels of nodes,
+// checked against std::map
+void against_std_map()
+{
+	BTreeMap<int, int> map;
+	std::map<int, int> reference;
+	std::srand(42);
+	
+	for(int i = 0; i < 200000; ++i)
+	{
+		int key = std::rand() % 20000;
+		if(std::rand() % 3 == 0)
+		{
+			if(reference.erase(key) == 1)
+			{
+				ASSERT_NOTHROW(map.remove(key))
+			}
+			else
+			{
+				ASSERT_THROWS(map.remove(key), std::out_of_range)
+			}
+		}
+		else
+		{
+			reference[key] = i;
+			map.set(key, i);
+		}
+	}
+	
+	ASSERT(map.count() == reference.size())
+	auto iter = map.begin();
+	for(const auto &[key, value] : reference)
+	{
+		ASSERT(iter != map.end())
+		ASSERT(iter.key() == key)
+		ASSERT(iter.value() == value)
+		++iter;
+	}
+	ASSERT(iter == map.end())
+	
+	for(int key = -1; key <= 20000; ++key)
+	{
+		auto lower = reference.lower_bound(key);
+		auto upper = reference.upper_bound(key);
+		ASSERT((map.lower_bound(key) == map.end()) == (lower == reference.end()))
+		ASSERT((map.upper_bound(key) == map.end()) == (upper == reference.end()))
+		if(lower != reference.end())
+		{
+			ASSERT(map.lower_bound(key).key() == lower -> first)
+		}
+		if(upper != reference.end())
+		{
+			ASSERT(map.upper_bound(key).key() == upper -> first)
+		}
+	}
+	
+	// remove everything, the tree should shrink back down to nothing
+	for(const auto &[key, value] : reference)
+	{
+		ASSERT_NOTHROW(map.remove(key))
+	}
+	ASSERT(map.count() == 0)
+	ASSERT(map.memory_usage() == 0)
+	ASSERT(map.begin() == map.end())
+}
+
+void build_from_sorted()
+{
+	Vector<std::pair<int, int>> elements;
+	for(int i = 0; i < 100000; ++i)
+	{
+		elements.add_back({i * 3, i});
+	}
+	BTreeMap<int, int> map(elements);
+	
+	ASSERT(map.count() == 100000)
+	for(int i = 0; i < 100000; ++i)
+	{
+		ASSERT(map.get(i * 3) == i)
+		ASSERT_FALSE(map.contains(i * 3 + 1))
+	}
+	
+	// range iteration over [30, 60)
+	int sum = 0;
+	for(auto iter = map.lower_bound(30), end = map.lower_bound(60); iter != end; ++iter)
+	{
+		sum += iter.value();
+	}
+	ASSERT(sum == 10 + 11 + 12 + 13 + 14 + 15 + 16 + 17 + 18 + 19)
+	
+	// the bulk loaded tree should keep working with regular inserts and removes
+	for(int i = 0; i < 100000; i += 2)
+	{
+		map.set(i * 3 + 1, -i);
+		map.remove(i * 3);
+	}
+	ASSERT(map.count() == 100000)
+	ASSERT(map.get(7) == -2)
+	ASSERT(map.get(3) == 1)
+	ASSERT_FALSE(map.contains(6))
+	
+	Vector<std::pair<int, int>> unsorted{{2, 0}, {1, 0}};
+	ASSERT_THROWS((BTreeMap<int, int>(unsorted)), std::invalid_argument)
+}
+
+void range_based_for_loop()
+{
+	BTreeMap<int, int> map;
+	for(int i = 9; i >= 0; --i)
+	{
+		map.set(i, i * i);
+	}
+	
+	std::string straccum;
+	
+	for(auto [key, value] : map)
+	{
+		straccum += std::to_string(key);
+		value = -value;
+	}
+	
+	ASSERT(straccum == "0123456789")
+	ASSERT(map.get(3) == -9)
+}
+
+void iterate_backwards()
+{
+	BTreeMap<int, int> single;
+	single.set(5, 50);
+	
+	// stepping back from end() should reach the last element, even with a single leaf
+	auto last = single.end();
+	--last;
+	ASSERT(last.key() == 5)
+	ASSERT(last == single.begin())
+	
+	BTreeMap<int, int> map;
+	for(int i = 0; i < 1000; ++i)
+	{
+		map.set(i, i);
+	}
+	
+	// walking from end() to begin() should visit every key across all the leaves
+	int expected = 999;
+	bool ordered = true;
+	auto iter = map.end();
+	while(iter != map.begin())
+	{
+		--iter;
+		ordered = ordered && iter.key() == expected--;
+	}
+	ASSERT(ordered)
+	ASSERT(expected == -1)
+	
+	iter = map.end();
+	iter--;
+	ASSERT(iter.value() == 999)
+	iter++;
+	ASSERT(iter == map.end())
+}
+
+int main()
+{
+	get_when_empty();
+	set_get_remove();
+	against_std_map();
+	build_from_sorted();
+	range_based_for_loop();
+	iterate_backwards();
+}
@@ -0,0 +1,105 @@
+#include "assert.hpp"
+#include "BitVector.hpp"
+
+void get_when_empty()
+{
+	BitVector bits;
+	
+	// expect to throw when accessing an empty bit vector
+	ASSERT(bits.count() == 0)
+	ASSERT(bits.count_ones() == 0)
+	ASSERT(bits.find_first() == 0)
+	ASSERT_THROWS(bits.get(0), std::out_of_range)
+	ASSERT_THROWS(bits.set(0, true), std::out_of_range)
+	ASSERT_THROWS(bits.remove_back(), std::out_of_range)
+}
+
+void get_set_after_add_back()
+{
+	BitVector bits;
+	
+	// every third bit set, across several words
+	for(int i = 0; i < 200; ++i)
+	{
+		bool value = i % 3 == 0;
+		ASSERT_NOTHROW(bits.add_back(value))
+	}
+	ASSERT(bits.count() == 200)
+	ASSERT(bits.words().count() == 4)
+	ASSERT(bits.count_ones() == 67)
+	ASSERT(bits.get(0))
+	ASSERT_FALSE(bits.get(1))
+	ASSERT(bits.get(198))
+	ASSERT_THROWS(bits.get(200), std::out_of_range)
+	
+	ASSERT_NOTHROW(bits.set(1, true))
+	ASSERT_NOTHROW(bits.set(0, false))
+	ASSERT(bits.get(1))
+	ASSERT_FALSE(bits.get(0))
+	ASSERT(bits.count_ones() == 67)
+	
+	// removing back past a word boundary drops the word
+	for(int i = 0; i < 73; ++i)
+	{
+		ASSERT_NOTHROW(bits.remove_back())
+	}
+	ASSERT(bits.count() == 127)
+	ASSERT(bits.words().count() == 2)
+	ASSERT(bits.count_ones() == 43)
+}
+
+void find_set_bits()
+{
+	BitVector bits(300, false);
+	bits.set(5, true);
+	bits.set(63, true);
+	bits.set(64, true);
+	bits.set(299, true);
+	
+	ASSERT(bits.find_first() == 5)
+	ASSERT(bits.find_next(5) == 63)
+	ASSERT(bits.find_next(63) == 64)
+	ASSERT(bits.find_next(64) == 299)
+	ASSERT(bits.find_next(299) == 300)
+	
+	BitVector full(130, true);
+	ASSERT(full.count_ones() == 130)
+	ASSERT(full.find_next(128) == 129)
+	ASSERT(full.find_next(129) == 130)
+}
+
+void bulk_operations()
+{
+	BitVector a(1000, false), b(1000, false);
+	for(int i = 0; i < 1000; ++i)
+	{
+		a.set(i, i % 2 == 0);
+		b.set(i, i % 3 == 0);
+	}
+	
+	BitVector both = a, either = a, one = a, only_a = a;
+	both &= b;
+	either |= b;
+	one ^= b;
+	only_a.and_not(b);
+	
+	for(int i = 0; i < 1000; ++i)
+	{
+		ASSERT(both.get(i) == (i % 6 == 0))
+		ASSERT(either.get(i) == (i % 2 == 0 || i % 3 == 0))
+		ASSERT(one.get(i) == ((i % 2 == 0) != (i % 3 == 0)))
+		ASSERT(only_a.get(i) == (i % 2 == 0 && i % 3 != 0))
+	}
+	ASSERT(both.count_ones() == 167)
+	
+	BitVector shorter(999, false);
+	ASSERT_THROWS(a &= shorter, std::invalid_argument)
+}
+
+int main()
+{
+	get_when_empty();
+	get_set_after_add_back();
+	find_set_bits();
+	bulk_operations();
+}
@@ -0,0 +1,83 @@
+#include "assert.hpp"
+#include "ConcurrentVector.hpp"
+
+#include <thread>
+
+void get_when_empty()
+{
+	ConcurrentVector<int> vec;
+	
+	// expect to throw when reading anything from an empty vector
+	ASSERT(vec.count() == 0)
+	ASSERT_THROWS(vec.get(0), std::out_of_range)
+}
+
+void add_across_segments()
+{
+	ConcurrentVector<int> vec;
+	for(int i = 0; i < 10000; ++i)
+	{
+		ASSERT(vec.add_back(i * 3) == std::size_t(i))
+	}
+	
+	// elements should keep their positions through every segment boundary
+	ASSERT(vec.count() == 10000)
+	for(int i = 0; i < 10000; ++i)
+	{
+		ASSERT(vec.get(i) == i * 3)
+	}
+	ASSERT_THROWS(vec.get(10000), std::out_of_range)
+}
+
+void references_stay_valid()
+{
+	ConcurrentVector<int> vec;
+	vec.add_back(42);
+	const int *first = &vec.get(0);
+	for(int i = 0; i < 5000; ++i)
+	{
+		vec.add_back(i);
+	}
+	
+	// growing should never move existing elements
+	ASSERT(first == &vec.get(0))
+	ASSERT(*first == 42)
+}
+
+void concurrent_writers()
+{
+	const int threads = 4, per_thread = 20000;
+	ConcurrentVector<int> vec;
+	std::thread writers[threads];
+	for(int t = 0; t < threads; ++t)
+	{
+		writers[t] = std::thread([&vec, t]
+		{
+			for(int i = 0; i < per_thread; ++i)
+			{
+				vec.add_back(t * per_thread + i);
+			}
+		});
+	}
+	for(std::thread &writer : writers)
+	{
+		writer.join();
+	}
+	
+	// every value should have been written exactly once
+	ASSERT(vec.count() == std::size_t(threads * per_thread))
+	bool seen[threads * per_thread] = {};
+	for(std::size_t i = 0; i < vec.count(); ++i)
+	{
+		ASSERT_FALSE(seen[vec.get(i)])
+		seen[vec.get(i)] = true;
+	}
+}
+
+int main()
+{
+	get_when_empty();
+	add_across_segments();
+	references_stay_valid();
+	concurrent_writers();
+}
@@ -0,0 +1,56 @@
+#include "assert.hpp"
+#include "FilteredHashMap.hpp"
+#include "Hashers.hpp"
+
+#include <string>
+
+template<class Map>
+void set_get_remove()
+{
+	Map map;
+	for(int i = 0; i < 5000; ++i)
+	{
+		map.set(i, i * 3);
+	}
+	map.set(10, 11);
+	
+	// the map should keep answering correctly while the filter is rebuilt behind it
+	ASSERT(map.count() == 5000)
+	ASSERT(map.filter().capacity() >= 5000)
+	for(int i = 0; i < 5000; ++i)
+	{
+		ASSERT(map.contains(i))
+		ASSERT(map.get(i) == (i == 10 ? 11 : i * 3))
+	}
+	ASSERT_FALSE(map.contains(-1))
+	ASSERT_THROWS(map.get(5000), std::out_of_range)
+	
+	map.remove(20);
+	ASSERT_FALSE(map.contains(20))
+	ASSERT_THROWS(map.get(20), std::out_of_range)
+	ASSERT_THROWS(map.remove(20), std::out_of_range)
+	ASSERT(map.count() == 4999)
+	
+	map.clear();
+	ASSERT(map.count() == 0)
+	ASSERT_FALSE(map.contains(1))
+}
+
+void bulk_build()
+{
+	Vector<std::pair<std::string, int>> elements = {{"a", 1}, {"b", 2}, {"a", 3}};
+	FilteredHashMap<std::string, int, Hasher, CuckooFilter<std::string, Hasher>> map(elements);
+	
+	// the filter should know every key of a bulk-built map
+	ASSERT(map.count() == 2)
+	ASSERT(map.get("a") == 3)
+	ASSERT(map.get("b") == 2)
+	ASSERT_FALSE(map.contains("c"))
+}
+
+int main()
+{
+	set_get_remove<FilteredHashMap<int, int, Hasher>>();
+	set_get_remove<FilteredHashMap<int, int, Hasher, CuckooFilter<int, Hasher>>>();
+	bulk_build();
+}
@@ -0,0 +1,94 @@
+#include "assert.hpp"
+#include "Filters.hpp"
+#include "Hashers.hpp"
+
+#include <cstdint>
+#include <string>
+
+void bloom_has_no_false_negatives()
+{
+	BlockedBloomFilter<std::uint64_t, Hasher> filter(10000);
+	for(std::uint64_t key = 0; key < 10000; ++key)
+	{
+		filter.add(key * 7);
+	}
+	
+	// every added key should pass, and only a few percent of the others
+	for(std::uint64_t key = 0; key < 10000; ++key)
+	{
+		ASSERT(filter.contains(key * 7))
+	}
+	int false_positives = 0;
+	for(std::uint64_t key = 0; key < 10000; ++key)
+	{
+		false_positives += filter.contains(key * 7 + 1);
+	}
+	ASSERT(false_positives < 200)
+	
+	filter.clear();
+	ASSERT_FALSE(filter.contains(7))
+}
+
+void cuckoo_add_remove()
+{
+	CuckooFilter<std::string, Hasher> filter(1000);
+	for(int i = 0; i < 1000; ++i)
+	{
+		ASSERT(filter.add(std::to_string(i)))
+	}
+	
+	// removed keys should stop passing while the rest keep passing
+	ASSERT(filter.count() == 1000)
+	for(int i = 0; i < 1000; i += 2)
+	{
+		ASSERT(filter.remove(std::to_string(i)))
+	}
+	ASSERT(filter.count() == 500)
+	int false_positives = 0;
+	for(int i = 0; i < 1000; ++i)
+	{
+		if(i % 2 == 1)
+		{
+			ASSERT(filter.contains(std::to_string(i)))
+		}
+		else
+		{
+			false_positives += filter.contains(std::to_string(i));
+		}
+	}
+	ASSERT(false_positives < 5)
+	ASSERT_FALSE(filter.remove("not added"))
+}
+
+void cuckoo_when_full()
+{
+	CuckooFilter<std::uint64_t, Hasher> filter(100);
+	std::uint64_t added = 0;
+	while(filter.add(added))
+	{
+		++added;
+	}
+	
+	// the key that did not fit should still be found, and removing a key should make room again
+	ASSERT(added >= 100)
+	for(std::uint64_t key = 0; key <= added; ++key)
+	{
+		ASSERT(filter.contains(key))
+	}
+	
+	// once the spare slot is taken, a refused key is not added at all
+	ASSERT_FALSE(filter.add(added + 1))
+	ASSERT_FALSE(filter.contains(added + 1))
+	ASSERT(filter.remove(0))
+	for(std::uint64_t key = 1; key <= added; ++key)
+	{
+		ASSERT(filter.contains(key))
+	}
+}
+
+int main()
+{
+	bloom_has_no_false_negatives();
+	cuckoo_add_remove();
+	cuckoo_when_full();
+}
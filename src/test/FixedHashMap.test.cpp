@@ -0,0 +1,83 @@
+#include "assert.hpp"
+#include "FixedHashMap.hpp"
+#include "Vector.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+struct Fnv1aHasher
+{
+	constexpr std::uint64_t operator()(std::string_view str) const noexcept
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		for(char c : str)
+		{
+			hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+		}
+		return hash;
+	}
+};
+
+struct IdentityHasher
+{
+	constexpr std::size_t operator()(int key) const noexcept
+	{
+		return static_cast<std::size_t>(key);
+	}
+};
+
+constexpr FixedHashMap<std::string_view, int, Fnv1aHasher, 16> COMMANDS{
+	{"GET", 1}, {"SET", 2}, {"DEL", 3}, {"INCR", 4}, {"DECR", 5}
+};
+
+// built through a Vector in a constant expression; the Vector's buffer is gone by the time it is stored
+constexpr auto SQUARES = []
+{
+	Vector<int> roots;
+	for(int i = 0; i < 20; ++i)
+	{
+		roots.add_back(i);
+	}
+	FixedHashMap<int, int, IdentityHasher, 32> squares;
+	for(int root : roots)
+	{
+		squares.set(root * root, root);
+	}
+	return squares;
+}();
+
+void compile_time_lookups()
+{
+	static_assert(COMMANDS.count() == 5);
+	static_assert(COMMANDS.get("GET") == 1);
+	static_assert(COMMANDS.get("DECR") == 5);
+	static_assert(!COMMANDS.contains("PING"));
+	
+	static_assert(SQUARES.count() == 20);
+	static_assert(SQUARES.get(361) == 19);
+	static_assert(!SQUARES.contains(2));
+}
+
+void runtime_lookups()
+{
+	ASSERT(COMMANDS.get("SET") == 2)
+	ASSERT(COMMANDS.contains("INCR"))
+	ASSERT_FALSE(COMMANDS.contains("incr"))
+	ASSERT_THROWS(COMMANDS.get("PING"), std::out_of_range)
+	
+	FixedHashMap<int, int, IdentityHasher, 4> small;
+	ASSERT_NOTHROW(small.set(1, 10))
+	ASSERT_NOTHROW(small.set(5, 50))  // collides with 1
+	ASSERT_NOTHROW(small.set(1, 11))
+	ASSERT_NOTHROW(small.set(2, 20))
+	ASSERT(small.get(1) == 11)
+	ASSERT(small.get(5) == 50)
+	ASSERT(small.count() == 3)
+	ASSERT_THROWS(small.set(3, 30), std::length_error)
+}
+
+int main()
+{
+	compile_time_lookups();
+	runtime_lookups();
+}
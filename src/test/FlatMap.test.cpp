@@ -0,0 +1,97 @@
+#include "assert.hpp"
+#include "FlatMap.hpp"
+
+#include <string>
+#include <utility>
+
+void get_when_empty()
+{
+	FlatMap<int, int> map;
+	
+	// expect to throw when looking up anything in an empty map
+	ASSERT(map.count() == 0)
+	ASSERT_FALSE(map.contains(0))
+	ASSERT_THROWS(map.get(0), std::out_of_range)
+	ASSERT_THROWS(map.remove(0), std::out_of_range)
+	ASSERT(map.lower_bound(5) == 0)
+	ASSERT(map.upper_bound(5) == 0)
+}
+
+void get_after_build()
+{
+	Vector<std::pair<int, std::string>> elements{{7, "seven"}, {3, "three"}, {9, "nine"}, {1, "one"}, {3, "THREE"}};
+	FlatMap<int, std::string> map(elements);
+	
+	// the duplicate key 3 should keep its last value
+	ASSERT(map.count() == 4)
+	ASSERT(map.get(1) == "one")
+	ASSERT(map.get(3) == "THREE")
+	ASSERT(map.get(7) == "seven")
+	ASSERT(map.get(9) == "nine")
+	ASSERT_THROWS(map.get(2), std::out_of_range)
+	ASSERT_THROWS(map.get(10), std::out_of_range)
+	
+	// keys should come out sorted
+	ASSERT(map.get_key(0) == 1)
+	ASSERT(map.get_key(1) == 3)
+	ASSERT(map.get_key(2) == 7)
+	ASSERT(map.get_key(3) == 9)
+}
+
+void set_remove()
+{
+	FlatMap<int, int> map;
+	
+	ASSERT_NOTHROW(map.set(5, 50))   // 5
+	ASSERT_NOTHROW(map.set(1, 10))   // 1 5
+	ASSERT_NOTHROW(map.set(3, 30))   // 1 3 5
+	ASSERT_NOTHROW(map.set(3, 33))   // 1 3 5
+	ASSERT(map.count() == 3)
+	ASSERT(map.get(3) == 33)
+	ASSERT(map.get_value(0) == 10)
+	ASSERT(map.get_value(2) == 50)
+	
+	ASSERT_NOTHROW(map.remove(1))    // 3 5
+	ASSERT(map.count() == 2)
+	ASSERT_FALSE(map.contains(1))
+	ASSERT(map.contains(3))
+	ASSERT(map.get_key(0) == 3)
+}
+
+void range_queries()
+{
+	Vector<std::pair<int, int>> elements;
+	for(int i = 0; i < 1000; ++i)
+	{
+		elements.add_back({i * 2, i});
+	}
+	FlatMap<int, int> map(elements);
+	
+	// every key and every gap between keys
+	for(int i = 0; i < 1000; ++i)
+	{
+		ASSERT(map.lower_bound(i * 2) == (FlatMap<int, int>::SizeType) i)
+		ASSERT(map.upper_bound(i * 2) == (FlatMap<int, int>::SizeType) i + 1)
+		ASSERT(map.lower_bound(i * 2 + 1) == (FlatMap<int, int>::SizeType) i + 1)
+		ASSERT(map.get(i * 2) == i)
+		ASSERT_FALSE(map.contains(i * 2 + 1))
+	}
+	ASSERT(map.lower_bound(-1) == 0)
+	ASSERT(map.upper_bound(5000) == 1000)
+	
+	// sum the values of keys in [100, 200)
+	int sum = 0;
+	for(auto pos = map.lower_bound(100), end = map.lower_bound(200); pos < end; ++pos)
+	{
+		sum += map.get_value(pos);
+	}
+	ASSERT(sum == 3725) // 50 + 51 + ... + 99
+}
+
+int main()
+{
+	get_when_empty();
+	get_after_build();
+	set_remove();
+	range_queries();
+}
@@ -0,0 +1,129 @@
+#include "assert.hpp"
+#include "FrozenHashMap.hpp"
+#include "Hashers.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+void get_when_empty()
+{
+	FrozenHashMap<int, int, Hasher> map(Hasher(), Vector<std::pair<int, int>>(0));
+	
+	// expect to throw when looking up anything in an empty map
+	ASSERT(map.count() == 0)
+	ASSERT_FALSE(map.contains(0))
+	ASSERT_THROWS(map.get(0), std::out_of_range)
+	ASSERT(map.keys().count() == 0)
+}
+
+void single_key()
+{
+	FrozenHashMap<int, int, Hasher> map(Hasher(), Vector<std::pair<int, int>>{ { 7, 70 } });
+	ASSERT(map.count() == 1)
+	ASSERT(map.contains(7))
+	ASSERT(map.get(7) == 70)
+	ASSERT_FALSE(map.contains(8))
+	ASSERT_THROWS(map.get(8), std::out_of_range)
+	
+	// values stay writable even though the key set is fixed
+	map.get(7) = 71;
+	ASSERT(map.get(7) == 71)
+}
+
+void duplicate_keys()
+{
+	FrozenHashMap<int, int, Hasher> map(Hasher(), Vector<std::pair<int, int>>{ { 1, 10 }, { 2, 20 }, { 1, 11 }, { 3, 30 }, { 1, 12 } });
+	
+	// the last occurrence of a key should win, and the duplicates should take no slot
+	ASSERT(map.count() == 3)
+	ASSERT(map.get(1) == 12)
+	ASSERT(map.get(2) == 20)
+	ASSERT(map.get(3) == 30)
+	ASSERT(map.keys().count() == 3)
+	ASSERT(map.values().count() == 3)
+}
+
+void string_keys()
+{
+	Vector<std::pair<std::string, int>> elements(0);
+	for(int i = 0; i < 1000; ++i)
+	{
+		elements.add_back({ "key " + std::to_string(i), i });
+	}
+	FrozenHashMap<std::string, int, Hasher> map(Hasher(), elements);
+	ASSERT(map.count() == 1000)
+	bool found = true;
+	for(int i = 0; i < 1000; ++i)
+	{
+		found = found && map.get("key " + std::to_string(i)) == i;
+	}
+	ASSERT(found)
+	ASSERT_FALSE(map.contains("key 1000"))
+	ASSERT_FALSE(map.contains(""))
+	ASSERT_THROWS(map.get("key"), std::out_of_range)
+	
+	// every key should be stored once, next to its own value
+	bool paired = true;
+	for(std::size_t i = 0; i < map.keys().count(); ++i)
+	{
+		paired = paired && map.get(map.keys().get(i)) == map.values().get(i);
+	}
+	ASSERT(paired)
+}
+
+struct LowBitHasher
+{
+	std::uint64_t operator()(long key) const noexcept
+	{
+		return static_cast<std::uint64_t>(key & 1);
+	}
+};
+
+void colliding_hashes()
+{
+	typedef std::pair<long, int> PairType;
+	
+	// different keys with the same hash can never be separated, so the build should refuse them
+	ASSERT_THROWS((FrozenHashMap<long, int, LowBitHasher>(LowBitHasher(), Vector<PairType>{ { 0, 0 }, { 2, 2 } })), std::invalid_argument)
+	ASSERT_THROWS((FrozenHashMap<long, int, LowBitHasher>(LowBitHasher(), Vector<PairType>{ { 1, 1 }, { 0, 0 }, { 1, 1 }, { 3, 3 } })), std::invalid_argument)
+	
+	// equal keys still collapse into one, and keys with different hashes are fine
+	FrozenHashMap<long, int, LowBitHasher> map(LowBitHasher(), Vector<PairType>{ { 0, 0 }, { 1, 1 }, { 0, 5 } });
+	ASSERT(map.count() == 2)
+	ASSERT(map.get(0) == 5)
+	ASSERT(map.get(1) == 1)
+	ASSERT_FALSE(map.contains(2))
+}
+
+void large_build()
+{
+	std::size_t length = 200000;
+	Vector<std::pair<std::uint64_t, std::uint64_t>> elements(length, { 0, 0 });
+	for(std::size_t i = 0; i < length; ++i)
+	{
+		elements.set(i, { i * 0x9E3779B97F4A7C15ull, i });
+	}
+	FrozenHashMap<std::uint64_t, std::uint64_t, Hasher> map(Hasher(), elements);
+	
+	// a perfect hash over many keys should still find each of them and nothing else
+	ASSERT(map.count() == length)
+	bool found = true, missing = true;
+	for(std::size_t i = 0; i < length; ++i)
+	{
+		found = found && map.get(i * 0x9E3779B97F4A7C15ull) == i;
+		missing = missing && !map.contains(i * 0x9E3779B97F4A7C15ull + 1);
+	}
+	ASSERT(found)
+	ASSERT(missing)
+}
+
+int main()
+{
+	get_when_empty();
+	single_key();
+	duplicate_keys();
+	string_keys();
+	colliding_hashes();
+	large_build();
+}
@@ -0,0 +1,169 @@
+#include "assert.hpp"
+#include "HashMap.hpp"
+#include "Hashers.hpp"
+
+#include <string>
+#include <utility>
+
+void get_when_empty()
+{
+	HashMap<int, int, Hasher> map;
+	
+	// expect to throw when looking up anything in an empty map
+	ASSERT(map.count() == 0)
+	ASSERT_FALSE(map.contains(0))
+	ASSERT_THROWS(map.get(0), std::out_of_range)
+	ASSERT_THROWS(map.remove(0), std::out_of_range)
+}
+
+void set_get_remove()
+{
+	HashMap<std::string, int, Hasher> map;
+	map.set("one", 1);
+	map.set("two", 2);
+	map.set("three", 3);
+	map.set("two", 22);
+	
+	// setting an existing key should overwrite its value
+	ASSERT(map.count() == 3)
+	ASSERT(map.get("one") == 1)
+	ASSERT(map.get("two") == 22)
+	ASSERT(map.get("three") == 3)
+	ASSERT_FALSE(map.contains("four"))
+	
+	map.remove("one");
+	ASSERT(map.count() == 2)
+	ASSERT_FALSE(map.contains("one"))
+	ASSERT(map.get("three") == 3)
+	ASSERT_THROWS(map.remove("one"), std::out_of_range)
+}
+
+void rehash_keeps_elements()
+{
+	HashMap<int, int, Hasher> map(Hasher(), 1);
+	for(int i = 0; i < 1000; ++i)
+	{
+		map.set(i, i * 2);
+	}
+	
+	// the table should have grown while keeping every element
+	ASSERT(map.count() == 1000)
+	ASSERT(map.bucket_count() > 1000)
+	for(int i = 0; i < 1000; ++i)
+	{
+		ASSERT(map.get(i) == i * 2)
+	}
+	for(int i = 0; i < 1000; i += 2)
+	{
+		map.remove(i);
+	}
+	ASSERT(map.count() == 500)
+	ASSERT_FALSE(map.contains(10))
+	ASSERT(map.get(11) == 22)
+}
+
+void batched_lookups()
+{
+	HashMap<int, int, Hasher> map;
+	for(int i = 0; i < 100; ++i)
+	{
+		map.set(i, -i);
+	}
+	Vector<int> keys(40, 0);
+	for(int i = 0; i < 40; ++i)
+	{
+		keys.set(i, i * 5);
+	}
+	Vector<int *> values(40, nullptr);
+	Vector<bool> found(40, false);
+	map.get_many(std::span<const int>(keys.cbegin(), keys.count()), std::span<int *>(values.begin(), values.count()));
+	map.contains_many(std::span<const int>(keys.cbegin(), keys.count()), std::span<bool>(found.begin(), found.count()));
+	
+	// keys below 100 should be found across several batches, the rest should not
+	for(int i = 0; i < 40; ++i)
+	{
+		ASSERT(found.get(i) == (i * 5 < 100))
+		ASSERT(i * 5 < 100 ? *values.get(i) == -i * 5 : values.get(i) == nullptr)
+	}
+	
+	// the pointers should be writable
+	*values.get(3) = 7;
+	ASSERT(map.get(15) == 7)
+	ASSERT_THROWS((map.contains_many(std::span<const int>(keys.cbegin(), 2), std::span<bool>(found.begin(), 3))), std::invalid_argument)
+}
+
+void bulk_build()
+{
+	Vector<std::pair<int, int>> elements(0);
+	for(int i = 0; i < 200000; ++i)
+	{
+		elements.add_back(std::pair<int, int>(i % 150000, i));
+	}
+	HashMap<int, int, Hasher> map(elements, Hasher(), 0.75f, 4);
+	
+	// duplicate keys should keep their last value, whichever thread inserted them
+	ASSERT(map.count() == 150000)
+	ASSERT(map.get(0) == 150000)
+	ASSERT(map.get(49999) == 199999)
+	ASSERT(map.get(50000) == 50000)
+	ASSERT(map.get(149999) == 149999)
+	ASSERT_FALSE(map.contains(150000))
+	
+	// the map should keep working normally afterwards
+	map.set(150000, 1);
+	map.remove(0);
+	ASSERT(map.count() == 150000)
+	ASSERT(map.get(150000) == 1)
+	
+	HashMap<int, int, Hasher> empty(Vector<std::pair<int, int>>(0));
+	ASSERT(empty.count() == 0)
+	ASSERT_FALSE(empty.contains(0))
+}
+
+void moved_from()
+{
+	HashMap<int, int, Hasher> map;
+	for(int i = 0; i < 100; ++i)
+	{
+		map.set(i, i);
+	}
+	
+	// a moved-from map should be empty but still usable
+	HashMap<int, int, Hasher> moved(std::move(map));
+	ASSERT(moved.count() == 100)
+	ASSERT(moved.get(99) == 99)
+	ASSERT(map.count() == 0)
+	ASSERT(map.bucket_count() > 0)
+	ASSERT_FALSE(map.contains(2))
+	ASSERT_THROWS(map.get(2), std::out_of_range)
+	ASSERT(map.begin() == map.end())
+	ASSERT_NOTHROW(map.set(2, 2))
+	ASSERT(map.get(2) == 2)
+	
+	HashMap<int, int, Hasher> assigned;
+	assigned = std::move(moved);
+	ASSERT(assigned.count() == 100)
+	ASSERT(moved.count() == 0)
+	ASSERT_NOTHROW(moved.set(3, 3))
+	for(int i = 0; i < 100; ++i)
+	{
+		moved.set(i, -i);
+	}
+	ASSERT(moved.get(50) == -50)
+	ASSERT(assigned.get(50) == 50)
+	
+	// copies should stay independent
+	HashMap<int, int, Hasher> copy = assigned;
+	copy.set(1, 10);
+	ASSERT(assigned.get(1) == 1)
+}
+
+int main()
+{
+	get_when_empty();
+	set_get_remove();
+	rehash_keeps_elements();
+	batched_lookups();
+	bulk_build();
+	moved_from();
+}
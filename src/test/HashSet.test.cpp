@@ -0,0 +1,120 @@
+#include "assert.hpp"
+#include "HashSet.hpp"
+#include "Hashers.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+void add_contains_remove()
+{
+	HashSet<std::string, Hasher> set(Hasher(), 1);
+	
+	// adding a key twice should store it once
+	ASSERT(set.add("one"))
+	ASSERT(set.add("two"))
+	ASSERT_FALSE(set.add("one"))
+	ASSERT(set.count() == 2)
+	ASSERT(set.contains("one"))
+	ASSERT_FALSE(set.contains("three"))
+	
+	set.remove("one");
+	ASSERT(set.count() == 1)
+	ASSERT_FALSE(set.contains("one"))
+	ASSERT_THROWS(set.remove("one"), std::out_of_range)
+	
+	Vector<std::string> keys = {"a", "b", "a", "c"};
+	HashSet<std::string, Hasher> built(keys);
+	ASSERT(built.count() == 3)
+	ASSERT(built.contains("c"))
+}
+
+void set_algebra()
+{
+	HashSet<int, Hasher> evens, threes, small;
+	for(int i = 0; i < 1000; ++i)
+	{
+		if(i % 2 == 0)
+		{
+			evens.add(i);
+		}
+		if(i % 3 == 0)
+		{
+			threes.add(i);
+		}
+	}
+	small.add(6);
+	small.add(12);
+	
+	// every operation should give the same keys whichever operand is the smaller one
+	HashSet<int, Hasher> both = evens.set_intersection(threes);
+	ASSERT(both.count() == 167)
+	ASSERT(threes.set_intersection(evens).count() == 167)
+	ASSERT(evens.intersection_count(threes) == 167)
+	for(int i = 0; i < 1000; ++i)
+	{
+		ASSERT(both.contains(i) == (i % 6 == 0))
+	}
+	
+	HashSet<int, Hasher> either = threes.set_union(evens);
+	ASSERT(either.count() == 500 + 334 - 167)
+	ASSERT(evens.set_union(threes).count() == either.count())
+	ASSERT(either.contains(9) && either.contains(4) && !either.contains(5))
+	
+	HashSet<int, Hasher> only_evens = evens.set_difference(threes);
+	ASSERT(only_evens.count() == 500 - 167)
+	ASSERT(only_evens.contains(4) && !only_evens.contains(6))
+	ASSERT(small.set_difference(evens).count() == 0)
+	ASSERT(evens.set_difference(small).count() == 498)
+	
+	ASSERT(small.is_subset_of(both))
+	ASSERT(both.is_subset_of(evens))
+	ASSERT_FALSE(evens.is_subset_of(both))
+	ASSERT_FALSE(threes.is_subset_of(evens))
+	HashSet<int, Hasher> empty;
+	ASSERT(empty.is_subset_of(small))
+}
+
+void sorted_integer_intersection()
+{
+	std::mt19937 rng(5);
+	Vector<std::uint32_t> a_elements(0), b_elements(0), tiny_elements(0);
+	for(int i = 0; i < 5000; ++i)
+	{
+		a_elements.add_back(rng() % 20000);
+		b_elements.add_back(rng() % 20000);
+	}
+	tiny_elements.add_back(b_elements.get(7));
+	tiny_elements.add_back(20001);
+	SortedIntegerSet<> a(a_elements), b(b_elements), tiny(tiny_elements);
+	
+	// the vectorised merge and the galloping search should both agree with one lookup per element
+	std::size_t expected = 0;
+	for(std::uint32_t value : a)
+	{
+		expected += b.contains(value);
+	}
+	SortedIntegerSet<> both = a.set_intersection(b);
+	ASSERT(both.count() == expected)
+	ASSERT(b.intersection_count(a) == expected)
+	for(std::size_t i = 0; i < both.count(); ++i)
+	{
+		ASSERT(a.contains(both.get(i)) && b.contains(both.get(i)))
+		ASSERT(i == 0 || both.get(i - 1) < both.get(i))
+	}
+	SortedIntegerSet<> found = b.set_intersection(tiny);
+	ASSERT(found.count() == 1 && found.get(0) == b_elements.get(7))
+	ASSERT(SortedIntegerSet<>().set_intersection(a).count() == 0)
+	
+	Vector<std::uint64_t> wide = {5, 1, 3, 3, 9, 7, 11};
+	SortedIntegerSet<std::uint64_t> odd(wide), low(Vector<std::uint64_t>{1, 2, 3, 4, 5, 6, 7});
+	ASSERT(odd.count() == 6)
+	ASSERT(odd.intersection_count(low) == 4)
+}
+
+int main()
+{
+	add_contains_remove();
+	set_algebra();
+	sorted_integer_intersection();
+}
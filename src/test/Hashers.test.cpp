@@ -0,0 +1,73 @@
+#include "assert.hpp"
+#include "Hashers.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+void single_byte_flips()
+{
+	std::mt19937 rng(3);
+	std::string text(2200, '\0');
+	for(char &c : text)
+	{
+		c = static_cast<char>(rng());
+	}
+	StringHasher hasher;
+	
+	// flipping any one bit of any byte should change the hash, on every path from short keys past
+	// the long key loop, including the bytes after its last whole stripe
+	bool all_changed = true;
+	for(std::size_t length = 1; length <= text.size(); length += length < 600 ? 1 : 7)
+	{
+		std::string key = text.substr(0, length);
+		std::uint64_t original = hasher(key);
+		for(std::size_t pos = 0; pos < length; ++pos)
+		{
+			char byte = key[pos];
+			key[pos] = static_cast<char>(byte ^ (1 << (pos % 8)));
+			all_changed = all_changed && hasher(key) != original;
+			key[pos] = byte;
+		}
+	}
+	ASSERT(all_changed)
+}
+
+void equal_keys_equal_hashes()
+{
+	std::string text(3000, 'q');
+	StringHasher hasher;
+	
+	// the hash should depend on the bytes only, not on where they are in memory
+	bool same = true;
+	for(std::size_t length = 0; length < 1200; ++length)
+	{
+		same = same && hasher(std::string_view(text.data(), length)) == hasher(std::string_view(text.data() + 3, length));
+	}
+	ASSERT(same)
+	
+	// keys that only differ in length should not collide
+	ASSERT(hasher("") != hasher(std::string_view("\0", 1)))
+	ASSERT(hasher(std::string(512, 'q')) != hasher(std::string(513, 'q')))
+}
+
+void integer_bits()
+{
+	IntegerHasher hasher;
+	
+	// neighbouring integers should differ in the low bits that pick a bucket
+	bool spread = true;
+	for(std::uint64_t i = 0; i < 64; ++i)
+	{
+		spread = spread && ((hasher(i) ^ hasher(i ^ (std::uint64_t(1) << i))) & 0xFF) != 0;
+	}
+	ASSERT(spread)
+}
+
+int main()
+{
+	single_byte_flips();
+	equal_keys_equal_hashes();
+	integer_bits();
+}
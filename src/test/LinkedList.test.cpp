@@ -0,0 +1,149 @@
+#include "assert.hpp"
+#include "LinkedList.hpp"
+
+#include <string>
+
+std::string joined(LinkedList<int> &list)
+{
+	std::string text;
+	for(int value : list)
+	{
+		text += std::to_string(value) + ",";
+	}
+	return text;
+}
+
+void remove_when_empty()
+{
+	LinkedList<int> list;
+	
+	// expect to throw when removing anything from an empty list
+	ASSERT(list.count() == 0)
+	ASSERT(list.begin() == list.end())
+	ASSERT(list.rbegin() == list.rend())
+	ASSERT_THROWS(list.remove_back(), std::out_of_range)
+	ASSERT_THROWS(list.remove_front(), std::out_of_range)
+	ASSERT_THROWS(list.remove(list.end()), std::out_of_range)
+	ASSERT_THROWS(*list.begin(), std::out_of_range)
+}
+
+void remove_last_then_add()
+{
+	LinkedList<int> list;
+	list.add_back(1);
+	ASSERT_NOTHROW(list.remove_back())
+	
+	// removing the only element should leave both ends usable again
+	ASSERT(list.count() == 0)
+	ASSERT(list.begin() == list.end())
+	list.add_back(2);
+	list.add_front(1);
+	ASSERT(joined(list) == "1,2,")
+	
+	ASSERT_NOTHROW(list.remove_front())
+	ASSERT_NOTHROW(list.remove_front())
+	ASSERT(list.count() == 0)
+	list.add_front(3);
+	list.add_back(4);
+	ASSERT(joined(list) == "3,4,")
+	
+	ASSERT_NOTHROW(list.remove(list.begin()))
+	ASSERT_NOTHROW(list.remove(list.begin()))
+	ASSERT(list.count() == 0)
+	ASSERT(list.rbegin() == list.rend())
+	list.add_back(5);
+	ASSERT(*list.begin() == 5)
+	ASSERT(*list.rbegin() == 5)
+}
+
+void remove_at_iterator()
+{
+	LinkedList<int> list = { 1, 2, 3, 4, 5 };
+	
+	// removing the head should return an iterator to the new head
+	auto it = list.remove(list.begin());
+	ASSERT(it == list.begin())
+	ASSERT(*it == 2)
+	ASSERT(joined(list) == "2,3,4,5,")
+	
+	// removing in the middle should link the neighbours together in both directions
+	++it;
+	it = list.remove(it);
+	ASSERT(*it == 4)
+	ASSERT(joined(list) == "2,4,5,")
+	auto rit = list.rbegin();
+	++rit;
+	++rit;
+	ASSERT(*rit == 2)
+	
+	// removing the tail should return the end iterator
+	it = list.begin();
+	++it;
+	++it;
+	it = list.remove(it);
+	ASSERT(it == list.end())
+	ASSERT(*list.rbegin() == 4)
+	ASSERT(list.count() == 2)
+	list.add_back(6);
+	ASSERT(joined(list) == "2,4,6,")
+}
+
+void copy_assign()
+{
+	LinkedList<int> list = { 1, 2, 3 };
+	
+	// a copy should not share any element with the original
+	LinkedList<int> copy = list;
+	*copy.begin() = 10;
+	copy.add_back(4);
+	ASSERT(joined(list) == "1,2,3,")
+	ASSERT(joined(copy) == "10,2,3,4,")
+	
+	LinkedList<int> assigned = { 7 };
+	assigned = list;
+	list.remove_back();
+	*list.begin() = 100;
+	ASSERT(joined(assigned) == "1,2,3,")
+	ASSERT(joined(list) == "100,2,")
+	
+	LinkedList<int> moved = std::move(copy);
+	ASSERT(copy.count() == 0)
+	ASSERT(joined(moved) == "10,2,3,4,")
+	copy.add_back(8);
+	ASSERT(joined(copy) == "8,")
+}
+
+void reverse_iteration()
+{
+	LinkedList<int> list;
+	for(int i = 0; i < 10; ++i)
+	{
+		list.add_back(i);
+	}
+	
+	// walking from rbegin to rend should visit every element backwards
+	std::string text;
+	for(auto it = list.rbegin(); it != list.rend(); ++it)
+	{
+		text += std::to_string(*it) + ",";
+	}
+	ASSERT(text == "9,8,7,6,5,4,3,2,1,0,")
+	
+	auto it = list.rbegin();
+	it++;
+	ASSERT(*it == 8)
+	it--;
+	ASSERT(*it == 9)
+	*it = 90;
+	ASSERT(*list.crbegin() == 90)
+	ASSERT(list.crend() == list.rend())
+}
+
+int main()
+{
+	remove_when_empty();
+	remove_last_then_add();
+	remove_at_iterator();
+	copy_assign();
+	reverse_iteration();
+}
@@ -0,0 +1,139 @@
+#include "assert.hpp"
+#include "Hashers.hpp"
+#include "LruCache.hpp"
+
+#include <memory>
+#include <string>
+#include <thread>
+
+void get_when_empty()
+{
+	LruCache<int, int, Hasher> cache(4);
+	
+	// every lookup in an empty cache should miss
+	ASSERT(cache.count() == 0)
+	ASSERT(cache.capacity() == 4)
+	ASSERT(cache.get(1) == nullptr)
+	ASSERT_FALSE(cache.contains(1))
+	ASSERT_THROWS(cache.remove(1), std::out_of_range)
+	ASSERT(cache.statistics().misses == 1)
+	ASSERT_THROWS((LruCache<int, int, Hasher>(0)), std::invalid_argument)
+}
+
+void evicts_least_recently_used()
+{
+	LruCache<std::string, int, Hasher> cache(3);
+	cache.put("a", 1);
+	cache.put("b", 2);
+	cache.put("c", 3);
+	
+	// using "a" should make "b" the oldest
+	ASSERT(*cache.get("a") == 1)
+	cache.put("d", 4);
+	ASSERT(cache.count() == 3)
+	ASSERT_FALSE(cache.contains("b"))
+	ASSERT(cache.contains("a"))
+	ASSERT(cache.contains("c"))
+	ASSERT(cache.contains("d"))
+	
+	// overwriting should also count as a use
+	cache.put("c", 30);
+	cache.put("e", 5);
+	ASSERT_FALSE(cache.contains("a"))
+	ASSERT(*cache.get("c") == 30)
+	
+	ASSERT(cache.statistics().hits == 2)
+	ASSERT(cache.statistics().misses == 0)
+	ASSERT(cache.statistics().evictions == 2)
+}
+
+void remove_and_reuse()
+{
+	LruCache<int, int, Hasher> cache(100);
+	for(int i = 0; i < 1000; ++i)
+	{
+		cache.put(i, i * i);
+	}
+	
+	// only the last hundred elements should survive
+	ASSERT(cache.count() == 100)
+	ASSERT(cache.get(899) == nullptr)
+	ASSERT(*cache.get(900) == 810000)
+	ASSERT(cache.statistics().evictions == 900)
+	
+	cache.remove(950);
+	ASSERT(cache.count() == 99)
+	ASSERT_FALSE(cache.contains(950))
+	cache.put(2000, 1);
+	ASSERT(cache.count() == 100)
+	ASSERT(cache.contains(901))
+	
+	cache.clear();
+	ASSERT(cache.count() == 0)
+	cache.reset_statistics();
+	ASSERT(cache.statistics().evictions == 0)
+}
+
+void releases_values()
+{
+	LruCache<int, std::shared_ptr<int>, Hasher> cache(2);
+	std::shared_ptr<int> first = std::make_shared<int>(1), second = std::make_shared<int>(2);
+	cache.put(1, first);
+	cache.put(2, second);
+	ASSERT(first.use_count() == 2)
+	
+	// an evicted value should be let go right away, not when its slot is reused
+	cache.put(3, std::make_shared<int>(3));
+	ASSERT_FALSE(cache.contains(1))
+	ASSERT(first.use_count() == 1)
+	
+	// and so should a removed or cleared one
+	cache.remove(2);
+	ASSERT(second.use_count() == 1)
+	cache.put(2, second);
+	cache.clear();
+	ASSERT(second.use_count() == 1)
+	ASSERT(cache.count() == 0)
+}
+
+void sharded_cache()
+{
+	ShardedLruCache<int, int, Hasher, 4> cache(4000);
+	std::thread threads[4];
+	for(int t = 0; t < 4; ++t)
+	{
+		threads[t] = std::thread([&cache, t]
+		{
+			for(int i = 0; i < 1000; ++i)
+			{
+				cache.put(t * 1000 + i, i);
+			}
+		});
+	}
+	for(std::thread &thread : threads)
+	{
+		thread.join();
+	}
+	
+	// the shards should hold at least what fits and answer from any thread
+	ASSERT(cache.count() > 3000)
+	ASSERT(cache.count() <= 4000)
+	int value = -1;
+	int hits = 0;
+	for(int key = 0; key < 4000; ++key)
+	{
+		hits += cache.get(key, value);
+	}
+	ASSERT(std::size_t(hits) == cache.count())
+	ASSERT(cache.statistics().hits == std::uint64_t(hits))
+	ASSERT_FALSE(cache.get(-5, value))
+}
+
+int main()
+{
+	get_when_empty();
+	evicts_least_recently_used();
+	remove_and_reuse();
+	releases_values();
+	sharded_cache();
+}
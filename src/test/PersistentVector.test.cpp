@@ -0,0 +1,124 @@
+#include "assert.hpp"
+#include "PersistentVector.hpp"
+
+#include <string>
+
+void get_when_empty()
+{
+	PersistentVector<int> vec;
+	
+	// expect to throw when accessing an empty vector
+	ASSERT(vec.count() == 0)
+	ASSERT_THROWS(vec.get(0), std::out_of_range)
+	ASSERT_THROWS(vec.get_back(), std::out_of_range)
+	ASSERT_THROWS((void) vec.set(0, 1), std::out_of_range)
+	ASSERT_THROWS((void) vec.remove_back(), std::out_of_range)
+	ASSERT(vec.begin() == vec.end())
+}
+
+void versions_are_independent()
+{
+	PersistentVector<int> empty;
+	PersistentVector<int> one = empty.add_back(1);
+	PersistentVector<int> two = one.add_back(2);
+	PersistentVector<int> changed = two.set(0, 10);
+	PersistentVector<int> popped = changed.remove_back();
+	
+	ASSERT(empty.count() == 0)
+	ASSERT(one.count() == 1)
+	ASSERT(one.get(0) == 1)
+	ASSERT(two.count() == 2)
+	ASSERT(two.get(0) == 1)
+	ASSERT(two.get(1) == 2)
+	ASSERT(changed.get(0) == 10)
+	ASSERT(changed.get(1) == 2)
+	ASSERT(popped.count() == 1)
+	ASSERT(popped.get_back() == 10)
+	
+	// pushing onto a popped version must not overwrite the slot still used by the version it came from
+	PersistentVector<int> branched = popped.add_back(3);
+	ASSERT(branched.get(1) == 3)
+	ASSERT(changed.get(1) == 2)
+}
+
+// enough elements for a trie three levels deep
+void large_versions()
+{
+	constexpr int LEN = 40000;
+	PersistentVector<int> vec;
+	for(int i = 0; i < LEN; ++i)
+	{
+		vec = vec.add_back(i);
+	}
+	ASSERT(vec.count() == LEN)
+	
+	PersistentVector<int> snapshot = vec;
+	for(int i = 0; i < LEN; i += 7)
+	{
+		vec = vec.set(i, -i);
+	}
+	for(int i = 0; i < LEN; ++i)
+	{
+		ASSERT(snapshot.get(i) == i)
+		ASSERT(vec.get(i) == (i % 7 == 0 ? -i : i))
+	}
+	
+	// pop all the way down, checking the back at every trie boundary
+	PersistentVector<int> shrinking = snapshot;
+	for(int i = LEN - 1; i >= 0; --i)
+	{
+		ASSERT(shrinking.get_back() == i)
+		shrinking = shrinking.remove_back();
+	}
+	ASSERT(shrinking.count() == 0)
+	ASSERT(snapshot.count() == LEN)
+	ASSERT(snapshot.get(LEN - 1) == LEN - 1)
+	
+	long long sum = 0;
+	for(int elem : snapshot)
+	{
+		sum += elem;
+	}
+	ASSERT(sum == (long long) LEN * (LEN - 1) / 2)
+}
+
+void transient_batches()
+{
+	PersistentVector<std::string> base{"a", "b", "c"};
+	PersistentVector<std::string>::TransientType transient = base.transient();
+	
+	for(int i = 0; i < 2000; ++i)
+	{
+		transient.add_back(std::to_string(i));
+	}
+	transient.set(0, "A");
+	transient.remove_back();
+	PersistentVector<std::string> first = transient.persistent();
+	
+	// edits after persistent() must not show up in the snapshot
+	transient.set(1, "B");
+	transient.set(1500, "changed");
+	transient.add_back("last");
+	PersistentVector<std::string> second = transient.persistent();
+	
+	ASSERT(base.count() == 3)
+	ASSERT(base.get(0) == "a")
+	ASSERT(first.count() == 2002)
+	ASSERT(first.get(0) == "A")
+	ASSERT(first.get(1) == "b")
+	ASSERT(first.get(1500) == "1497")
+	ASSERT(first.get_back() == "1998")
+	ASSERT(second.count() == 2003)
+	ASSERT(second.get(1) == "B")
+	ASSERT(second.get(1500) == "changed")
+	ASSERT(second.get_back() == "last")
+	ASSERT_THROWS(transient.set(2003, "x"), std::out_of_range)
+}
+
+int main()
+{
+	get_when_empty();
+	versions_are_independent();
+	large_versions();
+	transient_batches();
+}
@@ -0,0 +1,105 @@
+#include "assert.hpp"
+#include "PriorityQueue.hpp"
+
+#include <functional>
+#include <random>
+
+void get_when_empty()
+{
+	PriorityQueue<int> queue;
+	
+	// expect to throw when looking at or removing from an empty queue
+	ASSERT(queue.count() == 0)
+	ASSERT_THROWS(queue.get_top(), std::out_of_range)
+	ASSERT_THROWS(queue.remove_top(), std::out_of_range)
+}
+
+void comes_out_in_order()
+{
+	std::mt19937 rng(3);
+	Vector<int> elements(0);
+	for(int i = 0; i < 1000; ++i)
+	{
+		elements.add_back(static_cast<int>(rng() % 500));
+	}
+	PriorityQueue<int> heapified(elements);
+	PriorityQueue<int> added;
+	for(int elem : elements)
+	{
+		added.add(elem);
+	}
+	
+	// both ways of building should hand the elements back smallest first
+	ASSERT(heapified.count() == 1000)
+	int previous = -1;
+	for(int i = 0; i < 1000; ++i)
+	{
+		ASSERT(heapified.get_top() == added.get_top())
+		ASSERT(heapified.get_top() >= previous)
+		previous = heapified.get_top();
+		heapified.remove_top();
+		added.remove_top();
+	}
+	ASSERT(heapified.count() == 0)
+}
+
+void batch_add_and_custom_order()
+{
+	PriorityQueue<int, std::greater<int>> queue;
+	queue.add(5);
+	queue.add_many(Vector<int>{1, 9, 3});
+	queue.add_many(Vector<int>{7});
+	
+	// with std::greater the largest element should come first
+	ASSERT(queue.count() == 5)
+	ASSERT(queue.get_top() == 9)
+	queue.remove_top();
+	ASSERT(queue.get_top() == 7)
+	queue.remove_top();
+	ASSERT(queue.get_top() == 5)
+	queue.clear();
+	ASSERT(queue.count() == 0)
+}
+
+void indexed_decrease_key()
+{
+	IndexedPriorityQueue<int> queue(10);
+	for(int id = 0; id < 10; ++id)
+	{
+		queue.add(id, 100 - id);
+	}
+	
+	// the lowest priority should be on top until another id is moved past it
+	ASSERT(queue.get_top() == 9)
+	ASSERT(queue.get_top_priority() == 91)
+	queue.change_priority(3, 1);
+	ASSERT(queue.get_top() == 3)
+	queue.change_priority(3, 200);
+	ASSERT(queue.get_top() == 9)
+	ASSERT(queue.get_priority(3) == 200)
+	ASSERT_THROWS(queue.add(3, 5), std::invalid_argument)
+	
+	queue.remove(9);
+	ASSERT_FALSE(queue.contains(9))
+	ASSERT(queue.get_top() == 8)
+	queue.set(9, 0);
+	ASSERT(queue.get_top() == 9)
+	
+	int previous = -1000;
+	while(queue.count() > 0)
+	{
+		ASSERT(queue.get_top_priority() >= previous)
+		previous = queue.get_top_priority();
+		queue.remove_top();
+	}
+	ASSERT(previous == 200)
+	ASSERT_THROWS(queue.remove(3), std::out_of_range)
+}
+
+int main()
+{
+	get_when_empty();
+	comes_out_in_order();
+	batch_add_and_custom_order();
+	indexed_decrease_key();
+}
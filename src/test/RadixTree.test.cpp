@@ -0,0 +1,218 @@
+#include "assert.hpp"
+#include "RadixTree.hpp"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+
+void set_get_remove()
+{
+	RadixTree<std::string, int> tree;
+	
+	// expect to throw when looking up anything in an empty tree
+	ASSERT_FALSE(tree.contains("a"))
+	ASSERT_THROWS(tree.get("a"), std::out_of_range)
+	ASSERT_THROWS(tree.remove("a"), std::out_of_range)
+	
+	// keys that are prefixes of other keys, including the empty key
+	ASSERT_NOTHROW(tree.set("romane", 1))
+	ASSERT_NOTHROW(tree.set("romanus", 2))
+	ASSERT_NOTHROW(tree.set("rom", 3))
+	ASSERT_NOTHROW(tree.set("", 4))
+	ASSERT_NOTHROW(tree.set("rubens", 5))
+	ASSERT_NOTHROW(tree.set("rom", 6))
+	ASSERT(tree.count() == 5)
+	ASSERT(tree.get("romane") == 1)
+	ASSERT(tree.get("romanus") == 2)
+	ASSERT(tree.get("rom") == 6)
+	ASSERT(tree.get("") == 4)
+	ASSERT_FALSE(tree.contains("roma"))
+	ASSERT_FALSE(tree.contains("romanes"))
+	ASSERT_FALSE(tree.contains("r"))
+	
+	ASSERT_NOTHROW(tree.remove("rom"))
+	ASSERT_THROWS(tree.remove("rom"), std::out_of_range)
+	ASSERT_NOTHROW(tree.remove("romane"))
+	ASSERT(tree.count() == 3)
+	ASSERT(tree.get("romanus") == 2)
+	ASSERT(tree.get("rubens") == 5)
+	
+	tree.clear();
+	ASSERT(tree.count() == 0)
+	ASSERT(tree.memory_usage() == 0)
+	ASSERT_FALSE(tree.contains(""))
+}
+
+void long_prefixes()
+{
+	RadixTree<std::string, int> tree;
+	std::string base(40, 'x');
+	
+	// the keys part past the stored bytes of the compressed prefix
+	tree.set(base + "a", 1);
+	tree.set(base + "b", 2);
+	tree.set(base.substr(0, 20) + "y", 3);
+	tree.set(base.substr(0, 30), 4);
+	ASSERT(tree.get(base + "a") == 1)
+	ASSERT(tree.get(base + "b") == 2)
+	ASSERT(tree.get(base.substr(0, 20) + "y") == 3)
+	ASSERT(tree.get(base.substr(0, 30)) == 4)
+	ASSERT_FALSE(tree.contains(base.substr(0, 35)))
+	ASSERT_FALSE(tree.contains(base.substr(0, 30) + "z" + base.substr(0, 9) + "a"))
+	
+	// removing should merge the prefixes back without losing keys
+	tree.remove(base.substr(0, 20) + "y");
+	tree.remove(base.substr(0, 30));
+	ASSERT(tree.get(base + "a") == 1)
+	ASSERT(tree.get(base + "b") == 2)
+	tree.set(base.substr(0, 12) + "q", 5);
+	ASSERT(tree.get(base + "a") == 1)
+	ASSERT(tree.get(base.substr(0, 12) + "q") == 5)
+	ASSERT(tree.count() == 3)
+}
+
+void ordered_traversal()
+{
+	RadixTree<int, int> tree;
+	std::map<int, int> expected;
+	for(int i = -500; i < 500; i += 3)
+	{
+		tree.set(i * 7919, i);
+		expected[i * 7919] = i;
+	}
+	
+	// signed integers should come out in numeric order, negative ones first
+	auto it = expected.begin();
+	bool in_order = true;
+	tree.for_each([&](int key, int value)
+	{
+		in_order = in_order && it != expected.end() && it -> first == key && it -> second == value;
+		++it;
+	});
+	ASSERT(in_order)
+	ASSERT(it == expected.end())
+}
+
+void prefix_iteration()
+{
+	RadixTree<std::string, int> strings;
+	strings.set("car", 1);
+	strings.set("cart", 2);
+	strings.set("carbon", 3);
+	strings.set("cat", 4);
+	strings.set("ca", 5);
+	std::string seen;
+	strings.for_each_with_prefix(std::string("car"), [&](const std::string &key, int)
+	{
+		seen += key + ",";
+	});
+	
+	// the prefix itself and everything under it, in order
+	ASSERT(seen == "car,carbon,cart,")
+	seen.clear();
+	strings.for_each_with_prefix(std::string("cb"), [&](const std::string &key, int)
+	{
+		seen += key;
+	});
+	ASSERT(seen.empty())
+	
+	// integer keys by their leading bytes, like the addresses of a subnet
+	RadixTree<std::uint32_t, int> addresses;
+	addresses.set(0x0A000001u, 1);
+	addresses.set(0x0A01FF02u, 2);
+	addresses.set(0x0A010003u, 3);
+	addresses.set(0x0B010004u, 4);
+	int sum = 0;
+	addresses.for_each_with_prefix(0x0A010000u, 2, [&](std::uint32_t, int value)
+	{
+		sum = sum * 10 + value;
+	});
+	ASSERT(sum == 32)
+	ASSERT_THROWS(addresses.for_each_with_prefix(0u, 5, [](std::uint32_t, int) {}), std::invalid_argument)
+}
+
+void random_against_map()
+{
+	std::mt19937 rng(5);
+	RadixTree<std::string, int> tree;
+	std::map<std::string, int> expected;
+	bool same = true;
+	for(int step = 0; step < 60000; ++step)
+	{
+		// short keys over a small alphabet share many prefixes and fill nodes of every size
+		std::string key;
+		for(std::size_t length = rng() % 6; length > 0; --length)
+		{
+			key += static_cast<char>(rng() % 4 == 0 ? 'a' + rng() % 3 : rng() % 256);
+		}
+		if(rng() % 3 == 0)
+		{
+			bool present = expected.erase(key) > 0;
+			if(present)
+			{
+				tree.remove(key);
+			}
+			same = same && !tree.contains(key);
+		}
+		else
+		{
+			tree.set(key, step);
+			expected[key] = step;
+		}
+	}
+	
+	// the tree should hold the same keys in the same order as std::map
+	ASSERT(same)
+	ASSERT(tree.count() == expected.size())
+	auto it = expected.begin();
+	tree.for_each([&](const std::string &key, int value)
+	{
+		same = same && it != expected.end() && it -> first == key && it -> second == value;
+		++it;
+	});
+	ASSERT(same)
+	for(const auto &entry : expected)
+	{
+		tree.remove(entry.first);
+	}
+	ASSERT(tree.count() == 0)
+	ASSERT(tree.memory_usage() == 0)
+}
+
+void random_integers()
+{
+	std::mt19937_64 rng(9);
+	RadixTree<std::uint64_t, std::uint64_t> tree;
+	std::map<std::uint64_t, std::uint64_t> expected;
+	for(int step = 0; step < 50000; ++step)
+	{
+		// a narrow range on top of random high bits, so that nodes both branch widely and collapse
+		std::uint64_t key = (rng() % 8) << 56 | rng() % 20000;
+		if(rng() % 2 == 0 && expected.erase(key) > 0)
+		{
+			tree.remove(key);
+		}
+		else
+		{
+			tree.set(key, step);
+			expected[key] = step;
+		}
+	}
+	bool same = tree.count() == expected.size();
+	for(const auto &entry : expected)
+	{
+		same = same && tree.get(entry.first) == entry.second;
+	}
+	ASSERT(same)
+}
+
+int main()
+{
+	set_get_remove();
+	long_prefixes();
+	ordered_traversal();
+	prefix_iteration();
+	random_against_map();
+	random_integers();
+}
@@ -0,0 +1,88 @@
+#include "assert.hpp"
+#include "SegmentedVector.hpp"
+
+#include <string>
+
+void get_when_empty()
+{
+	SegmentedVector<int> vec;
+	
+	// expect to throw when reading or removing anything from an empty vector
+	ASSERT(vec.count() == 0)
+	ASSERT(vec.capacity() == 0)
+	ASSERT_THROWS(vec.get(0), std::out_of_range)
+	ASSERT_THROWS(vec.get_back(), std::out_of_range)
+	ASSERT_THROWS(vec.remove_back(), std::out_of_range)
+	ASSERT(vec.begin() == vec.end())
+}
+
+void add_and_iterate()
+{
+	SegmentedVector<int> vec;
+	for(int i = 0; i < 1000; ++i)
+	{
+		vec.add_back(i);
+	}
+	
+	// indexing and iteration should agree across every block boundary
+	ASSERT(vec.count() == 1000)
+	ASSERT(vec.get_front() == 0)
+	ASSERT(vec.get_back() == 999)
+	int expected = 0;
+	for(int elem : vec)
+	{
+		ASSERT(elem == expected)
+		++expected;
+	}
+	ASSERT(expected == 1000)
+	vec.set(500, -1);
+	ASSERT(vec.get(500) == -1)
+}
+
+void addresses_are_stable()
+{
+	SegmentedVector<std::string> vec{"first"};
+	std::string *first = &vec.get(0);
+	for(int i = 0; i < 10000; ++i)
+	{
+		vec.add_back(std::to_string(i));
+	}
+	
+	// growing should never move an element
+	ASSERT(first == &vec.get(0))
+	ASSERT(*first == "first")
+}
+
+void shrinking_frees_blocks()
+{
+	SegmentedVector<int> vec;
+	for(int i = 0; i < 4096; ++i)
+	{
+		vec.add_back(i);
+	}
+	std::size_t full_capacity = vec.capacity();
+	for(int i = 0; i < 4000; ++i)
+	{
+		vec.remove_back();
+	}
+	
+	// only the blocks still holding elements, plus one spare, should remain
+	ASSERT(vec.count() == 96)
+	ASSERT(vec.capacity() < full_capacity / 8)
+	ASSERT(vec.get_back() == 95)
+	
+	SegmentedVector<int> copy(vec);
+	vec.clear();
+	ASSERT(vec.count() == 0)
+	ASSERT(vec.capacity() == 0)
+	ASSERT(copy.count() == 96)
+	ASSERT(copy.get(50) == 50)
+}
+
+int main()
+{
+	get_when_empty();
+	add_and_iterate();
+	addresses_are_stable();
+	shrinking_frees_blocks();
+}
@@ -0,0 +1,84 @@
+#include "assert.hpp"
+#include "SlotMap.hpp"
+
+#include <random>
+#include <string>
+
+void add_get_remove()
+{
+	SlotMap<std::string> map;
+	SlotMap<std::string>::Handle a = map.add("a");
+	SlotMap<std::string>::Handle b = map.add("b");
+	SlotMap<std::string>::Handle c = map.add("c");
+	
+	// removing from the middle should move the last element but keep its handle working
+	ASSERT(map.count() == 3)
+	map.remove(a);
+	ASSERT(map.count() == 2)
+	ASSERT_FALSE(map.contains(a))
+	ASSERT(map.get(b) == "b")
+	ASSERT(map.get(c) == "c")
+	ASSERT(*map.cbegin() == "c")
+	ASSERT_THROWS(map.get(a), std::out_of_range)
+	ASSERT_THROWS(map.remove(a), std::out_of_range)
+	
+	// a reused slot should not answer to the old handle
+	SlotMap<std::string>::Handle d = map.add("d");
+	ASSERT(d.index == a.index)
+	ASSERT_FALSE(d == a)
+	ASSERT_FALSE(map.contains(a))
+	ASSERT(map.get(d) == "d")
+	map.set(d, "dd");
+	ASSERT(map.get(d) == "dd")
+	ASSERT(map.handle_at(2) == d)
+	
+	map.clear();
+	ASSERT(map.count() == 0)
+	ASSERT_FALSE(map.contains(b))
+	ASSERT_FALSE(map.contains(d))
+}
+
+void random_churn()
+{
+	std::mt19937 rng(11);
+	SlotMap<int> map;
+	Vector<SlotMap<int>::Handle> live(0);
+	Vector<int> values(0);
+	for(int step = 0; step < 20000; ++step)
+	{
+		if(live.count() > 0 && rng() % 3 == 0)
+		{
+			std::size_t pos = rng() % live.count();
+			map.remove(live.get(pos));
+			live.set(pos, live.get_back());
+			values.set(pos, values.get_back());
+			live.remove_back();
+			values.remove_back();
+		}
+		else
+		{
+			live.add_back(map.add(step));
+			values.add_back(step);
+		}
+	}
+	
+	// every live handle should still reach its own value, and iteration should see them all
+	ASSERT(map.count() == live.count())
+	long long expected = 0, sum = 0;
+	for(std::size_t i = 0; i < live.count(); ++i)
+	{
+		ASSERT(map.get(live.get(i)) == values.get(i))
+		expected += values.get(i);
+	}
+	for(int value : map)
+	{
+		sum += value;
+	}
+	ASSERT(sum == expected)
+}
+
+int main()
+{
+	add_get_remove();
+	random_churn();
+}
@@ -0,0 +1,150 @@
+#include "assert.hpp"
+#include "SoAVector.hpp"
+
+#include <string>
+#include <tuple>
+#include <utility>
+
+typedef SoAVector<int, std::string, double> RecordsType;
+
+void get_when_empty()
+{
+	RecordsType records;
+	
+	// expect to throw when accessing anything in an empty vector
+	ASSERT(records.count() == 0)
+	ASSERT_THROWS(records.get<0>(0), std::out_of_range)
+	ASSERT_THROWS(records.row(0), std::out_of_range)
+	ASSERT_THROWS(records.remove(0), std::out_of_range)
+	ASSERT_THROWS(records.remove_back(), std::out_of_range)
+	ASSERT_THROWS(records.set(0, 1, "one", 1.0), std::out_of_range)
+	ASSERT_THROWS(records.add(1, 1, "one", 1.0), std::out_of_range)
+	ASSERT(records.begin() == records.end())
+	ASSERT(records.column<1>().size() == 0)
+}
+
+void add_remove()
+{
+	RecordsType records;
+	ASSERT_NOTHROW(records.add_back(2, "two", 2.5))
+	ASSERT_NOTHROW(records.add_back(4, "four", 4.5))
+	ASSERT_NOTHROW(records.add(0, 1, "one", 1.5))
+	ASSERT_NOTHROW(records.add(2, 3, "three", 3.5))
+	
+	// rows inserted in the middle should shift every column together
+	ASSERT(records.count() == 4)
+	for(int i = 0; i < 4; ++i)
+	{
+		ASSERT(records.get<0>(i) == i + 1)
+		ASSERT(records.get<2>(i) == i + 1.5)
+	}
+	ASSERT(records.get<1>(2) == "three")
+	ASSERT_THROWS(records.get<1>(4), std::out_of_range)
+	
+	ASSERT_NOTHROW(records.remove(1))
+	ASSERT(records.count() == 3)
+	ASSERT(records.get<0>(1) == 3)
+	ASSERT(records.get<1>(1) == "three")
+	ASSERT_NOTHROW(records.remove_back())
+	ASSERT(records.count() == 2)
+	ASSERT(records.get<1>(1) == "three")
+	
+	ASSERT_NOTHROW(records.set(0, 10, "ten", 10.5))
+	ASSERT(records.get<1>(0) == "ten")
+	ASSERT(records.get<2>(0) == 10.5)
+}
+
+void columns()
+{
+	SoAVector<int, float> pairs;
+	for(int i = 0; i < 100; ++i)
+	{
+		pairs.add_back(i, i * 0.5f);
+	}
+	
+	// a column is one contiguous span of the live elements, and writes through it are seen by get
+	auto ints = pairs.column<0>();
+	ASSERT(ints.size() == 100)
+	ASSERT(ints.data() == pairs.data<0>())
+	int sum = 0;
+	for(int &value : ints)
+	{
+		sum += value;
+		value *= 2;
+	}
+	ASSERT(sum == 4950)
+	ASSERT(pairs.get<0>(99) == 198)
+	const SoAVector<int, float> &constant = pairs;
+	ASSERT(constant.column<1>()[10] == 5.0f)
+}
+
+void rows()
+{
+	RecordsType records;
+	records.add_back(1, "one", 1.5);
+	records.add_back(2, "two", 2.5);
+	
+	// reading a row gathers its fields, and assigning one scatters them back
+	std::tuple<int, std::string, double> first = records.row(0);
+	ASSERT(std::get<1>(first) == "one")
+	records.row(1) = std::make_tuple(20, std::string("twenty"), 20.5);
+	ASSERT(records.get<0>(1) == 20)
+	ASSERT(records.get<1>(1) == "twenty")
+	ASSERT(records.get<2>(1) == 20.5)
+	records.row(0).get<1>() = "uno";
+	ASSERT(records.get<1>(0) == "uno")
+	ASSERT(records.row(1).position() == 1)
+	
+	// iteration should visit the rows in order
+	std::string names;
+	for(auto row : records)
+	{
+		names += row.get<1>() + ",";
+	}
+	ASSERT(names == "uno,twenty,")
+	auto it = records.end();
+	--it;
+	ASSERT((*it).get<0>() == 20)
+}
+
+void copy_move_clear()
+{
+	RecordsType records;
+	for(int i = 0; i < 50; ++i)
+	{
+		records.add_back(i, std::to_string(i), i * 2.0);
+	}
+	
+	// a copy should not share any column with the original
+	RecordsType copy = records;
+	copy.set(0, -1, "minus one", -1.0);
+	ASSERT(records.get<1>(0) == "0")
+	ASSERT(copy.get<1>(0) == "minus one")
+	ASSERT(copy.count() == 50)
+	
+	RecordsType moved = std::move(copy);
+	ASSERT(moved.count() == 50)
+	ASSERT(moved.get<1>(49) == "49")
+	ASSERT(copy.count() == 0)
+	ASSERT_NOTHROW(copy.add_back(7, "seven", 7.0))
+	ASSERT(copy.get<1>(0) == "seven")
+	
+	moved = records;
+	ASSERT(moved.get<1>(0) == "0")
+	
+	ASSERT_NOTHROW(records.clear())
+	ASSERT(records.count() == 0)
+	ASSERT_THROWS(records.get<0>(0), std::out_of_range)
+	ASSERT(moved.count() == 50)
+	ASSERT_NOTHROW(records.add_back(1, "one", 1.0))
+	ASSERT(records.count() == 1)
+}
+
+int main()
+{
+	get_when_empty();
+	add_remove();
+	columns();
+	rows();
+	copy_move_clear();
+}
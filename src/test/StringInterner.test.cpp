@@ -0,0 +1,60 @@
+#include "assert.hpp"
+#include "StringInterner.hpp"
+
+#include <string>
+#include <string_view>
+
+void intern_and_resolve()
+{
+	StringInterner interner;
+	StringInterner::IdType apple = interner.intern("apple");
+	StringInterner::IdType pear = interner.intern("pear");
+	std::string copy = "apple";
+	
+	// equal strings should get equal ids, handed out from 0
+	ASSERT(apple == 0)
+	ASSERT(pear == 1)
+	ASSERT(interner.intern(copy) == apple)
+	ASSERT(interner.count() == 2)
+	ASSERT(interner.get(apple) == "apple")
+	ASSERT(interner.get(pear) == "pear")
+	ASSERT(interner.get_id("pear") == pear)
+	ASSERT(interner.contains("apple"))
+	ASSERT_FALSE(interner.contains("plum"))
+	ASSERT_THROWS(interner.get_id("plum"), std::out_of_range)
+	ASSERT_THROWS(interner.get(2), std::out_of_range)
+	
+	// the arena copy should not depend on the string it was interned from
+	copy[0] = 'X';
+	ASSERT(interner.get(apple) == "apple")
+	ASSERT(interner.get(interner.intern("")) == "")
+}
+
+void views_stay_valid()
+{
+	StringInterner interner;
+	std::string_view first = interner.get(interner.intern("first"));
+	std::string large(StringInterner::CHUNK_BYTES, 'x');
+	StringInterner::IdType large_id = interner.intern(large);
+	for(int i = 0; i < 100000; ++i)
+	{
+		interner.intern("string number " + std::to_string(i));
+	}
+	
+	// growing the arena and the tables should not move any stored string
+	ASSERT(first == "first")
+	ASSERT(first.data() == interner.get(0).data())
+	ASSERT(interner.get(large_id) == large)
+	ASSERT(interner.count() == 100002)
+	ASSERT(interner.get(interner.get_id("string number 99999")) == "string number 99999")
+	
+	StringInterner moved(std::move(interner));
+	ASSERT(moved.get(0) == "first")
+	ASSERT(moved.count() == 100002)
+}
+
+int main()
+{
+	intern_and_resolve();
+	views_stay_valid();
+}
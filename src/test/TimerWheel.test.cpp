@@ -0,0 +1,99 @@
+#include "assert.hpp"
+#include "TimerWheel.hpp"
+
+#include <random>
+#include <span>
+
+void fires_on_time()
+{
+	TimerWheel<int> wheel;
+	const std::uint64_t delays[] = {1, 5, 63, 64, 65, 100, 4095, 4096, 4097, 300000};
+	Vector<std::uint64_t> fired_at(10, 0);
+	for(int i = 0; i < 10; ++i)
+	{
+		wheel.schedule(delays[i], i);
+	}
+	ASSERT(wheel.count() == 10)
+	wheel.advance(400000, [&](std::span<int> expired)
+	{
+		for(int i : expired)
+		{
+			fired_at.set(i, wheel.now());
+		}
+	});
+	
+	// every timer should fire exactly on its tick, however many levels it had to cascade through
+	for(int i = 0; i < 10; ++i)
+	{
+		ASSERT(fired_at.get(i) == delays[i])
+	}
+	ASSERT(wheel.count() == 0)
+	ASSERT(wheel.now() == 400000)
+}
+
+void cancel_timers()
+{
+	TimerWheel<int> wheel(1000);
+	TimerWheel<int>::TimerHandle first = wheel.schedule(10, 1);
+	TimerWheel<int>::TimerHandle second = wheel.schedule(10, 2);
+	wheel.schedule(0, 3);
+	
+	// a cancelled timer should not fire, and cancelling twice should fail
+	ASSERT(wheel.cancel(first))
+	ASSERT_FALSE(wheel.cancel(first))
+	ASSERT(wheel.count() == 2)
+	int fired = 0, batches = 0;
+	wheel.advance(20, [&](std::span<int> expired)
+	{
+		++batches;
+		for(int payload : expired)
+		{
+			ASSERT(payload != 1)
+			++fired;
+		}
+	});
+	ASSERT(fired == 2)
+	ASSERT(batches == 2)
+	
+	// a handle of a timer that already fired should be stale, even after its node is reused
+	ASSERT_FALSE(wheel.cancel(second))
+	wheel.schedule(5, 4);
+	ASSERT_FALSE(wheel.cancel(second))
+	ASSERT(wheel.count() == 1)
+}
+
+void batches_and_random_delays()
+{
+	TimerWheel<std::uint64_t> wheel(12345);
+	std::mt19937_64 rng(7);
+	for(int i = 0; i < 20000; ++i)
+	{
+		std::uint64_t delay = rng() % 200000 + 1;
+		wheel.schedule(delay, wheel.now() + delay);
+	}
+	for(int i = 0; i < 100; ++i)
+	{
+		wheel.schedule(50, wheel.now() + 50);
+	}
+	
+	// payloads hold their expiry ticks, so every batch should match the tick it fired on
+	std::size_t fired = 0, largest_batch = 0;
+	wheel.advance(250000, [&](std::span<std::uint64_t> expired)
+	{
+		for(std::uint64_t expiry : expired)
+		{
+			ASSERT(expiry == wheel.now())
+		}
+		fired += expired.size();
+		largest_batch = expired.size() > largest_batch ? expired.size() : largest_batch;
+	});
+	ASSERT(fired == 20100)
+	ASSERT(largest_batch >= 100)
+}
+
+int main()
+{
+	fires_on_time();
+	cancel_timers();
+	batches_and_random_delays();
+}
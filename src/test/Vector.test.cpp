@@ -1,7 +1,11 @@
 #include "assert.hpp"
 #include "Vector.hpp"
+#include "AlignedStorage.hpp"
+
+#include <cstdint>
 
 #include <string>
+#include <type_traits>
 
 void get_when_empty()
 {
@@ -384,6 +388,175 @@ void iterators()
 	}
 }
 
+constexpr int sum_of_squares_after_edits()
+{
+	Vector<int> vec;
+	for(int i = 1; i <= 10; ++i)
+	{
+		vec.add_back(i * i);
+	}
+	vec.remove(0);
+	vec.add_front(1000);
+	vec.set_back(0);
+	vec.resize(32);
+	
+	int sum = 0;
+	for(int elem : vec)
+	{
+		sum += elem;
+	}
+	return sum;
+}
+
+void constant_evaluation()
+{
+	// 1000 + 4 + 9 + ... + 81, the 100 at the back having been zeroed
+	static_assert(sum_of_squares_after_edits() == 1284);
+	
+	constexpr auto copied_count = []
+	{
+		Vector<int> vec{1, 2, 3};
+		Vector<int> copy = vec;
+		copy.add_back(4);
+		return vec.count() * 10 + copy.count();
+	}();
+	static_assert(copied_count == 34);
+}
+
+template<class Storage>
+void storage_keeps_contents(std::size_t alignment)
+{
+	Vector<std::string, Storage> vec;
+	for(int i = 0; i < 5000; ++i)
+	{
+		vec.add_back(std::to_string(i));
+		ASSERT(reinterpret_cast<std::uintptr_t>(vec.begin()) % alignment == 0)
+	}
+	ASSERT_NOTHROW(vec.remove(0))
+	ASSERT(vec.count() == 4999)
+	ASSERT(vec.get_front() == "1")
+	ASSERT(vec.get_back() == "4999")
+	
+	Vector<std::string, Storage> copy = vec;
+	ASSERT_NOTHROW(vec.clear())
+	ASSERT(copy.count() == 4999)
+	ASSERT(copy.get(1000) == "1001")
+}
+
+void aligned_storage()
+{
+	storage_keeps_contents<AlignedStorage<CACHE_LINE_ALIGNMENT>>(CACHE_LINE_ALIGNMENT);
+	storage_keeps_contents<AlignedStorage<PAGE_ALIGNMENT>>(PAGE_ALIGNMENT);
+	
+	// a low threshold, so that the buffers past 4 KiB come from huge page mappings
+	storage_keeps_contents<AlignedStorage<CACHE_LINE_ALIGNMENT, 4096>>(CACHE_LINE_ALIGNMENT);
+	
+	Vector<int, AlignedStorage<CACHE_LINE_ALIGNMENT, 4096>> big(1 << 20);
+	ASSERT(reinterpret_cast<std::uintptr_t>(big.begin()) % HUGE_PAGE_SIZE == 0)
+}
+
+// Counts how often Vector moves it. Its destructor makes it not trivially copyable, but it holds
+// no pointer into itself, so it may opt in to being relocated by its bytes.
+template<bool Relocatable>
+struct Counted
+{
+	static inline int moves = 0;
+	int value = 0;
+	
+	Counted() noexcept = default;
+	
+	Counted(int value) noexcept
+		: value(value)
+	{}
+	
+	Counted(const Counted &) = default;
+	
+	Counted &operator=(const Counted &) = default;
+	
+	Counted &operator=(Counted &&other) noexcept
+	{
+		++moves;
+		value = other.value;
+		return *this;
+	}
+	
+	~Counted()
+	{}
+};
+
+template<>
+struct IsTriviallyRelocatable<Counted<true>> : std::true_type
+{};
+
+template<class Vec>
+bool holds_indices(const Vec &vec)
+{
+	bool same = true;
+	for(std::size_t i = 0; i < vec.count(); ++i)
+	{
+		same = same && static_cast<std::size_t>(vec.get(i)) == i;
+	}
+	return same;
+}
+
+void relocating_growth()
+{
+	Vector<Counted<true>> relocated;
+	Vector<Counted<false>> moved;
+	for(int i = 0; i < 100000; ++i)
+	{
+		relocated.add_back(Counted<true>(i));
+		moved.add_back(Counted<false>(i));
+	}
+	
+	// only the element that did not opt in should be moved one by one as the buffer grows
+	ASSERT(Counted<true>::moves == 0)
+	ASSERT(Counted<false>::moves > 0)
+	ASSERT(relocated.get(99999).value == 99999)
+	ASSERT(moved.get(99999).value == 99999)
+	relocated.resize(10);
+	ASSERT(relocated.count() == 10)
+	ASSERT(relocated.get(9).value == 9)
+	ASSERT(Counted<true>::moves == 0)
+	
+	// plain integers grow through realloc and keep their contents
+	Vector<std::uint64_t> integers;
+	for(std::uint64_t i = 0; i < (1 << 20); ++i)
+	{
+		integers.add_back(i);
+	}
+	ASSERT(holds_indices(integers))
+	
+	// huge page mappings grow through mremap and stay aligned to 2 MiB, past 4 KiB here
+	Vector<std::uint64_t, AlignedStorage<CACHE_LINE_ALIGNMENT, 4096>> mapped;
+	bool aligned = true;
+	for(std::uint64_t i = 0; i < (1 << 20); ++i)
+	{
+		mapped.add_back(i);
+		std::size_t alignment = mapped.capacity() * sizeof(std::uint64_t) >= 4096 ? HUGE_PAGE_SIZE : CACHE_LINE_ALIGNMENT;
+		aligned = aligned && reinterpret_cast<std::uintptr_t>(mapped.begin()) % alignment == 0;
+	}
+	ASSERT(aligned)
+	ASSERT(holds_indices(mapped))
+	while(mapped.count() > 100)
+	{
+		mapped.remove_back();
+	}
+	ASSERT(mapped.capacity() < 4096 / sizeof(std::uint64_t))
+	ASSERT(holds_indices(mapped))
+	
+	// the elements a mapping gains should be zero, also where a shrink left old bytes in its last page
+	Vector<std::uint64_t, AlignedStorage<CACHE_LINE_ALIGNMENT, 4096>> regrown(1 << 20, 7);
+	regrown.resize(1000);
+	regrown.resize(1 << 20);
+	bool zero = regrown.get(999) == 7;
+	for(std::size_t i = 1000; i < (1 << 20); ++i)
+	{
+		zero = zero && regrown.cbegin()[i] == 0;
+	}
+	ASSERT(zero)
+}
+
 int main()
 {
 	get_when_empty();
@@ -397,4 +570,7 @@ int main()
 	clear();
 	range_based_for_loop();
 	iterators();
+	constant_evaluation();
+	aligned_storage();
+	relocating_growth();
 }
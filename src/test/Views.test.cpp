@@ -0,0 +1,171 @@
+#include "assert.hpp"
+#include "Hashers.hpp"
+#include "Views.hpp"
+
+#include <string>
+#include <utility>
+
+void filter_transform_take()
+{
+	Vector<int> numbers{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	Vector<int> squares(0);
+	int calls = 0;
+	view(numbers).filter([&calls](int x)
+	{
+		++calls;
+		return x % 2 == 0;
+	}).transform([](int x)
+	{
+		return x * x;
+	}).take(3).collect_into(squares);
+	
+	// the filter should only have run as far as the third even number
+	ASSERT(squares.count() == 3)
+	ASSERT(squares.get(0) == 4)
+	ASSERT(squares.get(1) == 16)
+	ASSERT(squares.get(2) == 36)
+	ASSERT(calls == 6)
+}
+
+void drop_and_sized_collect()
+{
+	Vector<int> numbers{1, 2, 3, 4, 5};
+	Vector<int> collected{100};
+	view(numbers).drop(2).collect_into(collected);
+	
+	// the collected elements should be appended after the existing ones
+	ASSERT(collected.count() == 4)
+	ASSERT(collected.get(0) == 100)
+	ASSERT(collected.get(1) == 3)
+	ASSERT(collected.get(3) == 5)
+	ASSERT(view(numbers).drop(10).count() == 0)
+	ASSERT(view(numbers).take(10).count() == 5)
+}
+
+void zip_and_enumerate()
+{
+	Vector<int> numbers{1, 2, 3};
+	LinkedList<std::string> names{"one", "two", "three", "four"};
+	Vector<std::string> joined(0);
+	view(numbers).zip(view(names)).transform([](std::pair<int &, std::string &> pair)
+	{
+		return std::to_string(pair.first) + pair.second;
+	}).collect_into(joined);
+	
+	// the zip should stop at the shorter side
+	ASSERT(joined.count() == 3)
+	ASSERT(joined.get(0) == "1one")
+	ASSERT(joined.get(2) == "3three")
+	
+	std::size_t expected = 0;
+	for(std::pair<std::size_t, std::string &> pair : view(names).enumerate())
+	{
+		ASSERT(pair.first == expected)
+		++expected;
+	}
+	ASSERT(expected == 4)
+	
+	// elements should be reachable by reference through a view
+	for(int &x : view(numbers))
+	{
+		x *= 10;
+	}
+	ASSERT(numbers.get(2) == 30)
+}
+
+void chunks()
+{
+	Vector<int> numbers{1, 2, 3, 4, 5, 6, 7};
+	Vector<int> sums(0);
+	view(numbers).chunk(3).transform([](auto chunk)
+	{
+		int sum = 0;
+		for(int x : chunk)
+		{
+			sum += x;
+		}
+		return sum;
+	}).collect_into(sums);
+	
+	// the last chunk should hold what is left over
+	ASSERT(view(numbers).chunk(3).count() == 3)
+	ASSERT(sums.count() == 3)
+	ASSERT(sums.get(0) == 6)
+	ASSERT(sums.get(1) == 15)
+	ASSERT(sums.get(2) == 7)
+	
+	// the chunks themselves should be collectable, and stay readable afterwards
+	Vector<decltype(view(numbers).chunk(3).cursor().get())> collected(0);
+	view(numbers).chunk(3).collect_into(collected);
+	ASSERT(collected.count() == 3)
+	std::string text;
+	for(auto &chunk : collected)
+	{
+		for(int x : chunk)
+		{
+			text += std::to_string(x);
+		}
+		text += ",";
+	}
+	ASSERT(text == "123,456,7,")
+	
+	// also behind a filter, where the length is not known up front
+	auto odds = view(numbers).filter([](int x)
+	{
+		return x % 2 == 1;
+	});
+	Vector<decltype(odds.chunk(3).cursor().get())> odd_chunks(0);
+	odds.chunk(3).collect_into(odd_chunks);
+	ASSERT(odd_chunks.count() == 2)
+	int odd_sum = 0;
+	for(int x : odd_chunks.get(1))
+	{
+		odd_sum += x;
+	}
+	ASSERT(odd_sum == 7)
+}
+
+void hash_map_view()
+{
+	HashMap<int, int, Hasher> map;
+	for(int i = 0; i < 100; ++i)
+	{
+		map.set(i, i * 2);
+	}
+	Vector<int> keys(0);
+	view(map).filter([](const std::pair<int, int> &element)
+	{
+		return element.second % 4 == 0;
+	}).transform([](const std::pair<int, int> &element)
+	{
+		return element.first;
+	}).collect_into(keys);
+	
+	// every even key and nothing else should come out, in some order
+	ASSERT(keys.count() == 50)
+	int sum = 0;
+	for(int key : keys)
+	{
+		ASSERT(key % 2 == 0)
+		sum += key;
+	}
+	ASSERT(sum == 2450)
+	
+	const HashMap<int, int, Hasher> &const_map = map;
+	std::size_t visited = 0;
+	for(auto it = const_map.cbegin(); it != const_map.cend(); ++it)
+	{
+		++visited;
+	}
+	ASSERT(visited == 100)
+	ASSERT(view(const_map).count() == 100)
+}
+
+int main()
+{
+	filter_transform_take();
+	drop_and_sized_collect();
+	zip_and_enumerate();
+	chunks();
+	hash_map_view();
+}